@@ -0,0 +1,226 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelAnimation.h"
+
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace XboxFrontPanelAnimation
+{
+	static const int32 MaxLiteralRun = 128;
+	static const int32 MinRepeatRun = 2;
+	static const int32 MaxRepeatRun = 129;
+
+	// Repeats shorter than this cost more as their own token than inside a literal run.
+	static const int32 WorthwhileRepeatRun = 3;
+
+	static int32 GetRepeatLength(const uint8* Row, int32 X, int32 Width)
+	{
+		int32 Length = 1;
+		while (X + Length < Width && Length < MaxRepeatRun && Row[X + Length] == Row[X])
+		{
+			++Length;
+		}
+		return Length;
+	}
+
+	static void EncodeRleRow(const uint8* Row, int32 Width, TArray<uint8>& Out)
+	{
+		int32 X = 0;
+		while (X < Width)
+		{
+			const int32 RepeatLength = GetRepeatLength(Row, X, Width);
+			if (RepeatLength >= WorthwhileRepeatRun || (RepeatLength >= MinRepeatRun && X + RepeatLength == Width))
+			{
+				Out.Add(static_cast<uint8>(RepeatLength + 126));
+				Out.Add(Row[X]);
+				X += RepeatLength;
+				continue;
+			}
+
+			// Gather literals until the next worthwhile repeat
+			const int32 LiteralStart = X;
+			while (X < Width && X - LiteralStart < MaxLiteralRun && GetRepeatLength(Row, X, Width) < WorthwhileRepeatRun)
+			{
+				++X;
+			}
+			Out.Add(static_cast<uint8>(X - LiteralStart - 1));
+			Out.Append(Row + LiteralStart, X - LiteralStart);
+		}
+	}
+}
+
+FXboxFrontPanelAnimationWriter::FXboxFrontPanelAnimationWriter(int32 InWidth, int32 InHeight, float InFrameRate, int32 InKeyframeInterval)
+	: Width(InWidth)
+	, Height(InHeight)
+	, FrameRate(InFrameRate)
+	, KeyframeInterval(FMath::Max(InKeyframeInterval, 1))
+{
+	check(Width > 0 && Height > 0);
+	PreviousFrame.SetNumZeroed(Width * Height);
+}
+
+bool FXboxFrontPanelAnimationEncoder::EncodeFrame(const uint8* Pixels, int32 Pitch, uint8* PreviousFrame, int32 Width, int32 Height, bool bKeyframe, TArray<uint8>& Out)
+{
+	bool bFrameChanged = bKeyframe;
+	const int32 RecordStart = Out.Num();
+
+	TArray<uint8> RleRow;
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		const uint8* Row = Pixels + Y * Pitch;
+		uint8* PreviousRow = PreviousFrame + Y * Width;
+
+		if (!bKeyframe && FMemory::Memcmp(Row, PreviousRow, Width) == 0)
+		{
+			Out.Add(static_cast<uint8>(EXboxFrontPanelAnimationRow::Skip));
+			continue;
+		}
+
+		bFrameChanged = true;
+		FMemory::Memcpy(PreviousRow, Row, Width);
+
+		RleRow.Reset();
+		XboxFrontPanelAnimation::EncodeRleRow(Row, Width, RleRow);
+		if (RleRow.Num() < Width)
+		{
+			Out.Add(static_cast<uint8>(EXboxFrontPanelAnimationRow::Rle));
+			Out.Append(RleRow);
+		}
+		else
+		{
+			Out.Add(static_cast<uint8>(EXboxFrontPanelAnimationRow::Raw));
+			Out.Append(Row, Width);
+		}
+	}
+
+	if (!bFrameChanged)
+	{
+		// A repeated frame needs no rows at all
+		Out.SetNum(RecordStart, false);
+	}
+	return bFrameChanged;
+}
+
+void FXboxFrontPanelAnimationWriter::AddFrame(const uint8* Pixels, int32 Pitch)
+{
+	const bool bKeyframe = Index.Num() % KeyframeInterval == 0;
+
+	FXboxFrontPanelAnimationIndexEntry& Entry = Index.AddDefaulted_GetRef();
+	Entry.Offset = FXboxFrontPanelAnimationHeader::SerializedSize + FrameData.Num();
+	Entry.bKeyframe = bKeyframe ? 1 : 0;
+
+	const int32 RecordStart = FrameData.Num();
+	FXboxFrontPanelAnimationEncoder::EncodeFrame(Pixels, Pitch, PreviousFrame.GetData(), Width, Height, bKeyframe, FrameData);
+	Entry.Size = static_cast<uint32>(FrameData.Num() - RecordStart);
+}
+
+TArray<uint8> FXboxFrontPanelAnimationWriter::Finish() const
+{
+	FXboxFrontPanelAnimationHeader Header;
+	Header.Magic = XboxFrontPanelAnimation::Magic;
+	Header.Version = XboxFrontPanelAnimation::Version;
+	Header.Width = Width;
+	Header.Height = Height;
+	Header.FrameRate = FrameRate;
+	Header.FrameCount = Index.Num();
+	Header.IndexOffset = FXboxFrontPanelAnimationHeader::SerializedSize + FrameData.Num();
+
+	TArray<uint8> File;
+	FMemoryWriter Writer(File);
+	Writer << Header;
+	check(File.Num() == FXboxFrontPanelAnimationHeader::SerializedSize);
+
+	Writer.Serialize(const_cast<uint8*>(FrameData.GetData()), FrameData.Num());
+	for (FXboxFrontPanelAnimationIndexEntry Entry : Index)
+	{
+		Writer << Entry;
+	}
+
+	return File;
+}
+
+bool FXboxFrontPanelAnimationWriter::SaveToFile(const FString& Filename) const
+{
+	return FFileHelper::SaveArrayToFile(Finish(), *Filename);
+}
+
+bool FXboxFrontPanelAnimationDecoder::DecodeFrame(const uint8* Record, int64 RecordSize, uint8* Dest, int32 DestPitch, int32 Width, int32 Height)
+{
+	// An empty record repeats the previous frame
+	if (RecordSize == 0)
+	{
+		return true;
+	}
+
+	const uint8* Read = Record;
+	const uint8* const End = Record + RecordSize;
+
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		if (Read >= End)
+		{
+			return false;
+		}
+
+		uint8* Row = Dest + Y * DestPitch;
+		switch (static_cast<EXboxFrontPanelAnimationRow>(*Read++))
+		{
+		case EXboxFrontPanelAnimationRow::Skip:
+			break;
+
+		case EXboxFrontPanelAnimationRow::Raw:
+			if (End - Read < Width)
+			{
+				return false;
+			}
+			FMemory::Memcpy(Row, Read, Width);
+			Read += Width;
+			break;
+
+		case EXboxFrontPanelAnimationRow::Rle:
+		{
+			// Runs are memset and literals memcpy, both of which are vectorized
+			int32 X = 0;
+			while (X < Width)
+			{
+				if (Read >= End)
+				{
+					return false;
+				}
+
+				const uint8 Control = *Read++;
+				if (Control < 128)
+				{
+					const int32 Count = Control + 1;
+					if (X + Count > Width || End - Read < Count)
+					{
+						return false;
+					}
+					FMemory::Memcpy(Row + X, Read, Count);
+					Read += Count;
+					X += Count;
+				}
+				else
+				{
+					const int32 Count = Control - 126;
+					if (X + Count > Width || Read >= End)
+					{
+						return false;
+					}
+					FMemory::Memset(Row + X, *Read++, Count);
+					X += Count;
+				}
+			}
+			break;
+		}
+
+		default:
+			return false;
+		}
+	}
+
+	return Read == End;
+}
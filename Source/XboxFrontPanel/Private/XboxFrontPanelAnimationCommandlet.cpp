@@ -0,0 +1,159 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelAnimationCommandlet.h"
+#include "XboxFrontPanelAnimation.h"
+#include "XboxFrontPanelModulePrivate.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_EDITOR
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#endif
+
+UXboxFrontPanelAnimationCommandlet::UXboxFrontPanelAnimationCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UXboxFrontPanelAnimationCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString Input;
+	FString Output;
+	float FrameRate = 30.0f;
+	int32 KeyframeInterval = 30;
+	FString Grid;
+	int32 MaxFrames = MAX_int32;
+
+	FParse::Value(*Params, TEXT("Input="), Input);
+	FParse::Value(*Params, TEXT("Output="), Output);
+	FParse::Value(*Params, TEXT("FrameRate="), FrameRate);
+	FParse::Value(*Params, TEXT("KeyframeInterval="), KeyframeInterval);
+	FParse::Value(*Params, TEXT("Grid="), Grid);
+	FParse::Value(*Params, TEXT("Frames="), MaxFrames);
+
+	if (Input.IsEmpty() || Output.IsEmpty() || FrameRate <= 0.0f)
+	{
+		UE_LOG(LogXboxFrontPanel, Error, TEXT("Usage: -run=XboxFrontPanelAnimation -Input=<image or directory> -Output=<file%s> [-FrameRate=30] [-KeyframeInterval=30] [-Grid=<Columns>x<Rows>] [-Frames=<Count>]"), XboxFrontPanelAnimation::Extension);
+		return 1;
+	}
+
+	int32 Columns = 1;
+	int32 Rows = 1;
+	if (!Grid.IsEmpty())
+	{
+		FString ColumnText;
+		FString RowText;
+		if (!Grid.Split(TEXT("x"), &ColumnText, &RowText) || (Columns = FCString::Atoi(*ColumnText)) <= 0 || (Rows = FCString::Atoi(*RowText)) <= 0)
+		{
+			UE_LOG(LogXboxFrontPanel, Error, TEXT("-Grid must be <Columns>x<Rows>, not %s."), *Grid);
+			return 1;
+		}
+	}
+
+	TArray<FString> Images;
+	if (IFileManager::Get().DirectoryExists(*Input))
+	{
+		TArray<FString> Found;
+		IFileManager::Get().FindFiles(Found, *(Input / TEXT("*.*")), true, false);
+		Found.Sort();
+		for (const FString& File : Found)
+		{
+			const FString Extension = FPaths::GetExtension(File).ToLower();
+			if (Extension == TEXT("png") || Extension == TEXT("bmp") || Extension == TEXT("jpg") || Extension == TEXT("jpeg"))
+			{
+				Images.Add(Input / File);
+			}
+		}
+	}
+	else
+	{
+		Images.Add(Input);
+	}
+
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+	TUniquePtr<FXboxFrontPanelAnimationWriter> Writer;
+	int32 FrameWidth = 0;
+	int32 FrameHeight = 0;
+	TArray<uint8> Frame;
+
+	for (const FString& Image : Images)
+	{
+		TArray<uint8> Compressed;
+		if (!FFileHelper::LoadFileToArray(Compressed, *Image))
+		{
+			UE_LOG(LogXboxFrontPanel, Error, TEXT("Cannot read %s."), *Image);
+			return 1;
+		}
+
+		const EImageFormat Format = ImageWrapperModule.DetectImageFormat(Compressed.GetData(), Compressed.Num());
+		TSharedPtr<IImageWrapper> ImageWrapper = Format != EImageFormat::Invalid ? ImageWrapperModule.CreateImageWrapper(Format) : nullptr;
+		const TArray<uint8>* Pixels = nullptr;
+		if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(Compressed.GetData(), Compressed.Num()) || !ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, Pixels) || Pixels == nullptr)
+		{
+			UE_LOG(LogXboxFrontPanel, Error, TEXT("Cannot decode %s."), *Image);
+			return 1;
+		}
+
+		const int32 ImageWidth = ImageWrapper->GetWidth();
+		const int32 ImageHeight = ImageWrapper->GetHeight();
+		if (ImageWidth % Columns != 0 || ImageHeight % Rows != 0)
+		{
+			UE_LOG(LogXboxFrontPanel, Error, TEXT("%s is %dx%d, which does not divide into a %dx%d grid."), *Image, ImageWidth, ImageHeight, Columns, Rows);
+			return 1;
+		}
+
+		if (!Writer.IsValid())
+		{
+			FrameWidth = ImageWidth / Columns;
+			FrameHeight = ImageHeight / Rows;
+			Writer = MakeUnique<FXboxFrontPanelAnimationWriter>(FrameWidth, FrameHeight, FrameRate, KeyframeInterval);
+			Frame.SetNumUninitialized(FrameWidth * FrameHeight);
+		}
+		else if (ImageWidth / Columns != FrameWidth || ImageHeight / Rows != FrameHeight)
+		{
+			UE_LOG(LogXboxFrontPanel, Error, TEXT("%s has %dx%d frames, but earlier images have %dx%d."), *Image, ImageWidth / Columns, ImageHeight / Rows, FrameWidth, FrameHeight);
+			return 1;
+		}
+
+		const uint32 ImagePitch = ImageWidth * 4;
+		for (int32 Cell = 0; Cell < Columns * Rows && Writer->GetFrameCount() < MaxFrames; ++Cell)
+		{
+			const uint8* CellPixels = Pixels->GetData() + (Cell / Columns) * FrameHeight * ImagePitch + (Cell % Columns) * FrameWidth * 4;
+			FXboxFrontPanelLuminance::ConvertBGRA8ToR8(CellPixels, ImagePitch, Frame.GetData(), FrameWidth, FrameWidth, FrameHeight);
+			Writer->AddFrame(Frame.GetData(), FrameWidth);
+		}
+	}
+
+	if (!Writer.IsValid() || Writer->GetFrameCount() == 0)
+	{
+		UE_LOG(LogXboxFrontPanel, Error, TEXT("No frames found in %s."), *Input);
+		return 1;
+	}
+
+	const TArray<uint8> File = Writer->Finish();
+	if (!FFileHelper::SaveArrayToFile(File, *Output))
+	{
+		UE_LOG(LogXboxFrontPanel, Error, TEXT("Cannot write %s."), *Output);
+		return 1;
+	}
+
+	const int32 RawSize = Writer->GetFrameCount() * FrameWidth * FrameHeight;
+	UE_LOG(LogXboxFrontPanel, Display, TEXT("Wrote %s: %d frames of %dx%d at %.2f fps, %d bytes (%.1f%% of uncompressed)."),
+		*Output, Writer->GetFrameCount(), FrameWidth, FrameHeight, FrameRate, File.Num(), 100.0 * File.Num() / FMath::Max(RawSize, 1));
+	return 0;
+#else
+	// Image decoding is only linked into editor builds
+	UE_LOG(LogXboxFrontPanel, Error, TEXT("XboxFrontPanelAnimation needs an editor build to decode images."));
+	return 1;
+#endif
+}
@@ -0,0 +1,28 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "XboxFrontPanelAnimationCommandlet.generated.h"
+
+/**
+* Cooks an image sequence or flipbook sheet into a front panel animation (see XboxFrontPanelAnimation.h).
+*
+* Usage: -run=XboxFrontPanelAnimation -Input=<image or directory> -Output=<file.fpanim>
+*		[-FrameRate=30] [-KeyframeInterval=30] [-Grid=<Columns>x<Rows>] [-Frames=<Count>]
+*
+* A directory contributes its PNG, BMP and JPEG images in name order.  With -Grid each image is a flipbook sheet cut
+* into cells left to right, top to bottom; -Frames drops unused cells at the end.  Every frame must be the size of
+* the panel screen it will play on.  Only editor builds link the image decoders it needs.
+*/
+UCLASS()
+class UXboxFrontPanelAnimationCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UXboxFrontPanelAnimationCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,198 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelAnimationPlayer.h"
+#include "XboxFrontPanelModulePrivate.h"
+
+#include "HAL/PlatformFilemanager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Async/MappedFileHandle.h"
+#include "Serialization/MemoryReader.h"
+
+TUniquePtr<FXboxFrontPanelAnimationPlayer> FXboxFrontPanelAnimationPlayer::Open(const FString& Filename, bool bLoop)
+{
+	TUniquePtr<FXboxFrontPanelAnimationPlayer> Player(new FXboxFrontPanelAnimationPlayer(Filename, bLoop));
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	Player->MappedFile.Reset(PlatformFile.OpenMapped(*Filename));
+	if (!Player->MappedFile.IsValid())
+	{
+		Player->File.Reset(PlatformFile.OpenRead(*Filename));
+		if (!Player->File.IsValid())
+		{
+			UE_LOG(LogXboxFrontPanel, Warning, TEXT("Cannot open front panel animation %s."), *Filename);
+			return nullptr;
+		}
+	}
+
+	if (!Player->ReadIndex())
+	{
+		UE_LOG(LogXboxFrontPanel, Warning, TEXT("%s is not a valid front panel animation."), *Filename);
+		return nullptr;
+	}
+
+	return Player;
+}
+
+FXboxFrontPanelAnimationPlayer::FXboxFrontPanelAnimationPlayer(const FString& InFilename, bool bInLoop)
+	: Filename(InFilename)
+	, bLoop(bInLoop)
+	, bFinished(false)
+	, DecodedFrame(INDEX_NONE)
+{
+	FMemory::Memzero(Header);
+}
+
+FXboxFrontPanelAnimationPlayer::~FXboxFrontPanelAnimationPlayer()
+{
+}
+
+bool FXboxFrontPanelAnimationPlayer::ReadIndex()
+{
+	const int64 FileSize = MappedFile.IsValid() ? MappedFile->GetFileSize() : File->Size();
+	if (FileSize < FXboxFrontPanelAnimationHeader::SerializedSize)
+	{
+		return false;
+	}
+
+	// The header and index are read once and kept; frame records are fetched as they are decoded
+	TArray<uint8> Bytes;
+	Bytes.SetNumUninitialized(FXboxFrontPanelAnimationHeader::SerializedSize);
+	if (MappedFile.IsValid())
+	{
+		TUniquePtr<IMappedFileRegion> Region(MappedFile->MapRegion(0, Bytes.Num()));
+		if (!Region.IsValid())
+		{
+			return false;
+		}
+		FMemory::Memcpy(Bytes.GetData(), Region->GetMappedPtr(), Bytes.Num());
+	}
+	else if (!File->Seek(0) || !File->Read(Bytes.GetData(), Bytes.Num()))
+	{
+		return false;
+	}
+
+	FMemoryReader HeaderReader(Bytes);
+	HeaderReader << Header;
+
+	const int64 IndexSize = static_cast<int64>(Header.FrameCount) * FXboxFrontPanelAnimationIndexEntry::SerializedSize;
+	if (Header.Magic != XboxFrontPanelAnimation::Magic || Header.Version != XboxFrontPanelAnimation::Version ||
+		Header.Width == 0 || Header.Height == 0 || Header.FrameRate <= 0.0f || Header.FrameCount == 0 ||
+		Header.IndexOffset > static_cast<uint64>(FileSize) || static_cast<uint64>(IndexSize) > FileSize - Header.IndexOffset)
+	{
+		return false;
+	}
+
+	Bytes.SetNumUninitialized(IndexSize);
+	if (MappedFile.IsValid())
+	{
+		TUniquePtr<IMappedFileRegion> Region(MappedFile->MapRegion(Header.IndexOffset, IndexSize));
+		if (!Region.IsValid())
+		{
+			return false;
+		}
+		FMemory::Memcpy(Bytes.GetData(), Region->GetMappedPtr(), IndexSize);
+	}
+	else if (!File->Seek(Header.IndexOffset) || !File->Read(Bytes.GetData(), IndexSize))
+	{
+		return false;
+	}
+
+	FMemoryReader IndexReader(Bytes);
+	Index.SetNum(Header.FrameCount);
+	for (FXboxFrontPanelAnimationIndexEntry& Entry : Index)
+	{
+		IndexReader << Entry;
+		if (Entry.Offset < FXboxFrontPanelAnimationHeader::SerializedSize || Entry.Offset + Entry.Size > Header.IndexOffset)
+		{
+			return false;
+		}
+	}
+
+	// Playback has to be able to start somewhere
+	return Index[0].bKeyframe != 0;
+}
+
+int32 FXboxFrontPanelAnimationPlayer::FindKeyframe(int32 Frame) const
+{
+	while (Frame > 0 && Index[Frame].bKeyframe == 0)
+	{
+		--Frame;
+	}
+	return Frame;
+}
+
+bool FXboxFrontPanelAnimationPlayer::DecodeRecord(int32 Frame, uint8* Dest, int32 DestPitch)
+{
+	const FXboxFrontPanelAnimationIndexEntry& Entry = Index[Frame];
+	if (Entry.Size == 0)
+	{
+		return true;
+	}
+
+	if (MappedFile.IsValid())
+	{
+		// Mapped for the duration of the decode only, so the OS can drop the pages straight after
+		TUniquePtr<IMappedFileRegion> Region(MappedFile->MapRegion(Entry.Offset, Entry.Size));
+		return Region.IsValid() && FXboxFrontPanelAnimationDecoder::DecodeFrame(Region->GetMappedPtr(), Entry.Size, Dest, DestPitch, Header.Width, Header.Height);
+	}
+
+	RecordBuffer.SetNumUninitialized(Entry.Size, false);
+	return File->Seek(Entry.Offset) && File->Read(RecordBuffer.GetData(), Entry.Size) &&
+		FXboxFrontPanelAnimationDecoder::DecodeFrame(RecordBuffer.GetData(), Entry.Size, Dest, DestPitch, Header.Width, Header.Height);
+}
+
+bool FXboxFrontPanelAnimationPlayer::Update(double Elapsed, uint8* Dest, int32 DestPitch)
+{
+	if (bFinished)
+	{
+		return false;
+	}
+
+	const int32 FrameCount = Index.Num();
+	const int64 DueFrame = FMath::Max<int64>(static_cast<int64>(Elapsed * Header.FrameRate), 0);
+
+	int32 TargetFrame;
+	if (DueFrame < FrameCount)
+	{
+		TargetFrame = static_cast<int32>(DueFrame);
+	}
+	else if (bLoop)
+	{
+		TargetFrame = static_cast<int32>(DueFrame % FrameCount);
+	}
+	else
+	{
+		TargetFrame = FrameCount - 1;
+		bFinished = true;
+	}
+
+	if (TargetFrame == DecodedFrame)
+	{
+		return false;
+	}
+
+	// Continue from the frame on screen unless a keyframe gets there sooner, or playback wrapped around
+	const int32 Keyframe = FindKeyframe(TargetFrame);
+	const int32 FirstFrame = (DecodedFrame == INDEX_NONE || TargetFrame < DecodedFrame || Keyframe > DecodedFrame) ? Keyframe : DecodedFrame + 1;
+
+	bool bChanged = false;
+	{
+		FRONT_PANEL_SCOPED_STAGE(DecodeAnimation);
+		for (int32 Frame = FirstFrame; Frame <= TargetFrame; ++Frame)
+		{
+			if (!DecodeRecord(Frame, Dest, DestPitch))
+			{
+				UE_LOG(LogXboxFrontPanel, Warning, TEXT("Front panel animation %s is corrupt at frame %d; stopping."), *Filename, Frame);
+				bFinished = true;
+				DecodedFrame = INDEX_NONE;
+				return true;
+			}
+			bChanged |= Index[Frame].Size > 0;
+		}
+	}
+
+	DecodedFrame = TargetFrame;
+	return bChanged;
+}
@@ -0,0 +1,61 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "XboxFrontPanelAnimation.h"
+
+class IMappedFileHandle;
+class IFileHandle;
+
+/**
+* Streams a cooked front panel animation.  The file is memory mapped where the platform allows, with each frame record
+* mapped only while it is decoded, so the only memory held is the index and the frame the caller decodes into.
+* Platforms without mapped files read each record into a reused buffer instead.
+*/
+class FXboxFrontPanelAnimationPlayer
+{
+public:
+	/** @return		A player positioned before the first frame, or null if the file is missing or malformed. */
+	static TUniquePtr<FXboxFrontPanelAnimationPlayer> Open(const FString& Filename, bool bLoop);
+
+	~FXboxFrontPanelAnimationPlayer();
+
+	int32 GetWidth() const { return Header.Width; }
+	int32 GetHeight() const { return Header.Height; }
+
+	/**
+	* Bring Dest up to the frame due Elapsed seconds after playback started, decoding forward from the current frame or
+	* from the nearest keyframe, whichever is closer.
+	*
+	* @param Dest		Width x Height frame.  Must hold the previously decoded frame between calls.
+	*
+	* @return		True if Dest changed.
+	*/
+	bool Update(double Elapsed, uint8* Dest, int32 DestPitch);
+
+	/** @return		True once a non-looping animation has shown its last frame, or decoding failed. */
+	bool IsFinished() const { return bFinished; }
+
+private:
+	FXboxFrontPanelAnimationPlayer(const FString& InFilename, bool bInLoop);
+
+	bool ReadIndex();
+	bool DecodeRecord(int32 Frame, uint8* Dest, int32 DestPitch);
+	int32 FindKeyframe(int32 Frame) const;
+
+	FString Filename;
+	bool bLoop;
+	bool bFinished;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IFileHandle> File;
+	TArray<uint8> RecordBuffer;
+
+	FXboxFrontPanelAnimationHeader Header;
+	TArray<FXboxFrontPanelAnimationIndexEntry> Index;
+
+	// Frame currently held by the caller's buffer
+	int32 DecodedFrame;
+};
@@ -14,6 +14,31 @@ void UXboxFrontPanelBlueprintLibrary::SetScreenWidget(UUserWidget* Widget)
 	IXboxFrontPanelModule::Get().SetScreenWidget(Widget);
 }
 
+void UXboxFrontPanelBlueprintLibrary::MarkScreenDirty()
+{
+	IXboxFrontPanelModule::Get().MarkScreenDirty();
+}
+
+bool UXboxFrontPanelBlueprintLibrary::PrewarmScreen()
+{
+	return IXboxFrontPanelModule::Get().PrewarmScreen();
+}
+
+bool UXboxFrontPanelBlueprintLibrary::RegisterScreen(FName Name, UUserWidget* Widget)
+{
+	return IXboxFrontPanelModule::Get().RegisterScreen(Name, Widget);
+}
+
+void UXboxFrontPanelBlueprintLibrary::UnregisterScreen(FName Name)
+{
+	IXboxFrontPanelModule::Get().UnregisterScreen(Name);
+}
+
+bool UXboxFrontPanelBlueprintLibrary::ShowScreen(FName Name)
+{
+	return IXboxFrontPanelModule::Get().ShowScreen(Name);
+}
+
 void UXboxFrontPanelBlueprintLibrary::SetButtonLightState(EXboxFrontPanelButtonLight Light, bool OnOff)
 {
 	IXboxFrontPanelModule::Get().SetButtonLightState(Light, OnOff);
@@ -25,6 +50,41 @@ bool UXboxFrontPanelBlueprintLibrary::GetButtonLightState(EXboxFrontPanelButtonL
 
 }
 
+void UXboxFrontPanelBlueprintLibrary::SetButtonLightMask(int32 Mask)
+{
+	IXboxFrontPanelModule::Get().SetButtonLightMask(Mask);
+}
+
+int32 UXboxFrontPanelBlueprintLibrary::GetButtonLightMask()
+{
+	return IXboxFrontPanelModule::Get().GetButtonLightMask();
+}
+
+void UXboxFrontPanelBlueprintLibrary::PlayLightSequence(UXboxFrontPanelLightSequence* Sequence)
+{
+	IXboxFrontPanelModule::Get().PlayLightSequence(Sequence);
+}
+
+void UXboxFrontPanelBlueprintLibrary::StopLightSequence(UXboxFrontPanelLightSequence* Sequence)
+{
+	IXboxFrontPanelModule::Get().StopLightSequence(Sequence);
+}
+
+void UXboxFrontPanelBlueprintLibrary::StopAllLightSequences()
+{
+	IXboxFrontPanelModule::Get().StopAllLightSequences();
+}
+
+bool UXboxFrontPanelBlueprintLibrary::PlayAnimation(const FString& Filename, bool bLoop)
+{
+	return IXboxFrontPanelModule::Get().PlayAnimation(Filename, bLoop);
+}
+
+void UXboxFrontPanelBlueprintLibrary::StopAnimation()
+{
+	IXboxFrontPanelModule::Get().StopAnimation();
+}
+
 bool UXboxFrontPanelBlueprintLibrary::IsFrontPanelAvailable()
 {
 	return IXboxFrontPanelModule::Get().IsFrontPanelAvailable();
@@ -0,0 +1,96 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelButtonSampler.h"
+#include "XboxFrontPanelModulePrivate.h"
+
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+
+FXboxFrontPanelButtonSampler::FXboxFrontPanelButtonSampler(TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> InDevice, float InSampleRate)
+	: Device(MoveTemp(InDevice))
+	, SampleRate(InSampleRate)
+	, LatestSampleTimeBits(0)
+	, bStopping(false)
+	, Thread(nullptr)
+{
+	check(Device.IsValid());
+	check(SampleRate > 0.0f);
+
+	// Above normal so a busy game thread cannot starve sampling; each iteration is one device call and a sleep.
+	Thread = FRunnableThread::Create(this, TEXT("XboxFrontPanelButtonSampler"), 0, TPri_AboveNormal);
+}
+
+FXboxFrontPanelButtonSampler::~FXboxFrontPanelButtonSampler()
+{
+	if (Thread != nullptr)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+}
+
+bool FXboxFrontPanelButtonSampler::DequeueEdge(FXboxFrontPanelButtonEdge& OutEdge)
+{
+	return Edges.Dequeue(OutEdge);
+}
+
+double FXboxFrontPanelButtonSampler::GetLatestSampleTime() const
+{
+	const int64 Bits = FPlatformAtomics::AtomicRead(&LatestSampleTimeBits);
+
+	double Time;
+	FMemory::Memcpy(&Time, &Bits, sizeof(Time));
+	return Time;
+}
+
+uint32 FXboxFrontPanelButtonSampler::Run()
+{
+	const double SampleInterval = 1.0 / SampleRate;
+
+	EXboxFrontPanelButtons LastButtons = EXboxFrontPanelButtons::None;
+	while (!bStopping)
+	{
+		const double SampleTime = FPlatformTime::Seconds();
+
+		EXboxFrontPanelButtons Buttons;
+		bool bSampled;
+		{
+			FRONT_PANEL_SCOPED_STAGE(GetButtonStates);
+			bSampled = Device->GetButtonStates(Buttons);
+		}
+
+		if (bSampled)
+		{
+			if (Buttons != LastButtons)
+			{
+				FXboxFrontPanelButtonEdge Edge;
+				Edge.Buttons = Buttons;
+				Edge.Time = SampleTime;
+				Edges.Enqueue(Edge);
+
+				LastButtons = Buttons;
+			}
+
+			int64 Bits;
+			FMemory::Memcpy(&Bits, &SampleTime, sizeof(Bits));
+			FPlatformAtomics::InterlockedExchange(&LatestSampleTimeBits, Bits);
+		}
+
+		const double Remaining = SampleInterval - (FPlatformTime::Seconds() - SampleTime);
+		if (Remaining > 0.0)
+		{
+			FPlatformProcess::SleepNoStats(static_cast<float>(Remaining));
+		}
+	}
+
+	return 0;
+}
+
+void FXboxFrontPanelButtonSampler::Stop()
+{
+	bStopping = true;
+}
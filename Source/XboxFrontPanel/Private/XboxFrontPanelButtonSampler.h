@@ -0,0 +1,56 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Containers/Queue.h"
+#include "XboxFrontPanelDevice.h"
+
+class FRunnableThread;
+
+/** A change in the set of held buttons, stamped with the FPlatformTime::Seconds() of the sample that saw it. */
+struct FXboxFrontPanelButtonEdge
+{
+	EXboxFrontPanelButtons Buttons;
+	double Time;
+};
+
+/**
+* Thread that polls the front panel buttons at a fixed rate, independent of the game's frame rate.  Only changes
+* are queued, so presses shorter than a frame still produce a press and a release, and the game thread can time
+* repeats from when the sampler actually saw each edge.
+*/
+class FXboxFrontPanelButtonSampler :
+	public FRunnable
+{
+public:
+	FXboxFrontPanelButtonSampler(TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> InDevice, float InSampleRate);
+	virtual ~FXboxFrontPanelButtonSampler();
+
+	/** Take the oldest queued edge.  Game thread only. */
+	bool DequeueEdge(FXboxFrontPanelButtonEdge& OutEdge);
+
+	/** @return		Time of the most recent successful sample, or zero before the first. */
+	double GetLatestSampleTime() const;
+
+	float GetSampleRate() const { return SampleRate; }
+
+public:
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> Device;
+	float SampleRate;
+
+	TQueue<FXboxFrontPanelButtonEdge, EQueueMode::Spsc> Edges;
+
+	// Bit pattern of a double, so it can be published without a lock
+	volatile int64 LatestSampleTimeBits;
+
+	FThreadSafeBool bStopping;
+	FRunnableThread* Thread;
+};
@@ -0,0 +1,316 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelCanvas.h"
+
+// SSE2 is part of the x64 baseline, so unlike the luminance kernels these spans need no runtime dispatch.
+#if defined(_M_X64) || defined(__x86_64__)
+#define FRONT_PANEL_CANVAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define FRONT_PANEL_CANVAS_SSE2 0
+#endif
+
+namespace XboxFrontPanelCanvas
+{
+	// Rows start on a 16 byte boundary relative to the first pixel so full width spans stay vector aligned.
+	static const int32 RowAlignment = 16;
+
+	static void LightenSpan(uint8* Dest, const uint8* Src, int32 Count)
+	{
+		int32 X = 0;
+#if FRONT_PANEL_CANVAS_SSE2
+		for (; X + 16 <= Count; X += 16)
+		{
+			const __m128i SrcPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + X));
+			const __m128i DestPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Dest + X));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest + X), _mm_max_epu8(SrcPixels, DestPixels));
+		}
+#endif
+		for (; X < Count; ++X)
+		{
+			Dest[X] = FMath::Max(Dest[X], Src[X]);
+		}
+	}
+
+	static void DarkenSpan(uint8* Dest, const uint8* Src, int32 Count)
+	{
+		int32 X = 0;
+#if FRONT_PANEL_CANVAS_SSE2
+		for (; X + 16 <= Count; X += 16)
+		{
+			const __m128i SrcPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + X));
+			const __m128i DestPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Dest + X));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest + X), _mm_min_epu8(SrcPixels, DestPixels));
+		}
+#endif
+		for (; X < Count; ++X)
+		{
+			Dest[X] = FMath::Min(Dest[X], Src[X]);
+		}
+	}
+
+	// Divide by 255, rounded to nearest, exact for every product of two bytes.
+	static FORCEINLINE uint32 DivideBy255(uint32 Value)
+	{
+		return (Value + 128 + ((Value + 128) >> 8)) >> 8;
+	}
+
+	static void CoverageSpan(uint8* Dest, const uint8* Coverage, int32 Count, uint8 Value)
+	{
+		int32 X = 0;
+#if FRONT_PANEL_CANVAS_SSE2
+		// Dest * (255 - Coverage) + Value * Coverage fits in 16 bits, as does the rounding in DivideBy255.
+		const __m128i Zero = _mm_setzero_si128();
+		const __m128i Full = _mm_set1_epi16(255);
+		const __m128i Round = _mm_set1_epi16(128);
+		const __m128i Paint = _mm_set1_epi16(Value);
+		for (; X + 16 <= Count; X += 16)
+		{
+			const __m128i CoveragePixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Coverage + X));
+			const __m128i DestPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Dest + X));
+
+			__m128i Result[2];
+			for (int32 Half = 0; Half < 2; ++Half)
+			{
+				const __m128i Alpha = Half == 0 ? _mm_unpacklo_epi8(CoveragePixels, Zero) : _mm_unpackhi_epi8(CoveragePixels, Zero);
+				const __m128i Under = Half == 0 ? _mm_unpacklo_epi8(DestPixels, Zero) : _mm_unpackhi_epi8(DestPixels, Zero);
+				__m128i Sum = _mm_add_epi16(_mm_mullo_epi16(Under, _mm_sub_epi16(Full, Alpha)), _mm_mullo_epi16(Paint, Alpha));
+				Sum = _mm_add_epi16(Sum, Round);
+				Result[Half] = _mm_srli_epi16(_mm_add_epi16(Sum, _mm_srli_epi16(Sum, 8)), 8);
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest + X), _mm_packus_epi16(Result[0], Result[1]));
+		}
+#endif
+		for (; X < Count; ++X)
+		{
+			Dest[X] = static_cast<uint8>(DivideBy255(Dest[X] * (255u - Coverage[X]) + Value * static_cast<uint32>(Coverage[X])));
+		}
+	}
+
+	static void BlendSpan(EXboxFrontPanelCanvasBlend Blend, uint8* Dest, const uint8* Src, int32 Count)
+	{
+		switch (Blend)
+		{
+		case EXboxFrontPanelCanvasBlend::Lighten:
+			LightenSpan(Dest, Src, Count);
+			break;
+		case EXboxFrontPanelCanvasBlend::Darken:
+			DarkenSpan(Dest, Src, Count);
+			break;
+		default:
+			// Memmove, since a canvas may blit onto itself
+			FMemory::Memmove(Dest, Src, Count);
+			break;
+		}
+	}
+}
+
+FXboxFrontPanelCanvas::FXboxFrontPanelCanvas(int32 InWidth, int32 InHeight)
+	: Width(FMath::Max(InWidth, 0))
+	, Height(FMath::Max(InHeight, 0))
+	, Pitch(Align(Width, XboxFrontPanelCanvas::RowAlignment))
+	, ClipRect(0, 0, Width, Height)
+{
+	Pixels.SetNumZeroed(Pitch * Height);
+}
+
+void FXboxFrontPanelCanvas::SetClipRect(const FIntRect& Rect)
+{
+	ClipRect.Min.X = FMath::Clamp(Rect.Min.X, 0, Width);
+	ClipRect.Min.Y = FMath::Clamp(Rect.Min.Y, 0, Height);
+	ClipRect.Max.X = FMath::Clamp(Rect.Max.X, ClipRect.Min.X, Width);
+	ClipRect.Max.Y = FMath::Clamp(Rect.Max.Y, ClipRect.Min.Y, Height);
+}
+
+void FXboxFrontPanelCanvas::ResetClipRect()
+{
+	ClipRect = FIntRect(0, 0, Width, Height);
+}
+
+void FXboxFrontPanelCanvas::Clear(uint8 Value)
+{
+	FMemory::Memset(Pixels.GetData(), Value, Pixels.Num());
+}
+
+void FXboxFrontPanelCanvas::SetPixel(int32 X, int32 Y, uint8 Value)
+{
+	if (X >= ClipRect.Min.X && X < ClipRect.Max.X && Y >= ClipRect.Min.Y && Y < ClipRect.Max.Y)
+	{
+		Pixels[Y * Pitch + X] = Value;
+	}
+}
+
+uint8 FXboxFrontPanelCanvas::GetPixel(int32 X, int32 Y) const
+{
+	if (X >= 0 && X < Width && Y >= 0 && Y < Height)
+	{
+		return Pixels[Y * Pitch + X];
+	}
+	return 0;
+}
+
+void FXboxFrontPanelCanvas::FillRect(const FIntRect& Rect, uint8 Value)
+{
+	const int32 MinX = FMath::Max(Rect.Min.X, ClipRect.Min.X);
+	const int32 MinY = FMath::Max(Rect.Min.Y, ClipRect.Min.Y);
+	const int32 MaxX = FMath::Min(Rect.Max.X, ClipRect.Max.X);
+	const int32 MaxY = FMath::Min(Rect.Max.Y, ClipRect.Max.Y);
+	if (MinX >= MaxX || MinY >= MaxY)
+	{
+		return;
+	}
+
+	// Rows covering the full pitch are contiguous, so a full width fill is a single span
+	if (MinX == 0 && MaxX == Width && Width == Pitch)
+	{
+		FMemory::Memset(Pixels.GetData() + MinY * Pitch, Value, (MaxY - MinY) * Pitch);
+		return;
+	}
+
+	uint8* Row = Pixels.GetData() + MinY * Pitch + MinX;
+	for (int32 Y = MinY; Y < MaxY; ++Y)
+	{
+		FMemory::Memset(Row, Value, MaxX - MinX);
+		Row += Pitch;
+	}
+}
+
+void FXboxFrontPanelCanvas::DrawRect(const FIntRect& Rect, uint8 Value)
+{
+	if (Rect.Min.X >= Rect.Max.X || Rect.Min.Y >= Rect.Max.Y)
+	{
+		return;
+	}
+
+	FillRect(FIntRect(Rect.Min.X, Rect.Min.Y, Rect.Max.X, Rect.Min.Y + 1), Value);
+	FillRect(FIntRect(Rect.Min.X, Rect.Max.Y - 1, Rect.Max.X, Rect.Max.Y), Value);
+	FillRect(FIntRect(Rect.Min.X, Rect.Min.Y + 1, Rect.Min.X + 1, Rect.Max.Y - 1), Value);
+	FillRect(FIntRect(Rect.Max.X - 1, Rect.Min.Y + 1, Rect.Max.X, Rect.Max.Y - 1), Value);
+}
+
+void FXboxFrontPanelCanvas::DrawLine(FIntPoint Start, FIntPoint End, uint8 Value)
+{
+	// Axis aligned lines are spans
+	if (Start.Y == End.Y || Start.X == End.X)
+	{
+		FillRect(FIntRect(FMath::Min(Start.X, End.X), FMath::Min(Start.Y, End.Y), FMath::Max(Start.X, End.X) + 1, FMath::Max(Start.Y, End.Y) + 1), Value);
+		return;
+	}
+
+	// Nothing to draw when both ends are beyond the same edge of the clip rect
+	if ((Start.X < ClipRect.Min.X && End.X < ClipRect.Min.X) || (Start.X >= ClipRect.Max.X && End.X >= ClipRect.Max.X) ||
+		(Start.Y < ClipRect.Min.Y && End.Y < ClipRect.Min.Y) || (Start.Y >= ClipRect.Max.Y && End.Y >= ClipRect.Max.Y))
+	{
+		return;
+	}
+
+	// Bresenham, clipping per pixel.  Panel lines are short, so this costs less than clipping the end points exactly
+	// while still stepping the same pixels as the unclipped line.
+	const int32 DeltaX = FMath::Abs(End.X - Start.X);
+	const int32 DeltaY = -FMath::Abs(End.Y - Start.Y);
+	const int32 StepX = Start.X < End.X ? 1 : -1;
+	const int32 StepY = Start.Y < End.Y ? 1 : -1;
+
+	int32 Error = DeltaX + DeltaY;
+	FIntPoint Point = Start;
+	for (;;)
+	{
+		SetPixel(Point.X, Point.Y, Value);
+		if (Point == End)
+		{
+			break;
+		}
+
+		const int32 DoubleError = Error * 2;
+		if (DoubleError >= DeltaY)
+		{
+			Error += DeltaY;
+			Point.X += StepX;
+		}
+		if (DoubleError <= DeltaX)
+		{
+			Error += DeltaX;
+			Point.Y += StepY;
+		}
+	}
+}
+
+void FXboxFrontPanelCanvas::Blit(const uint8* Src, int32 SrcPitch, int32 SrcWidth, int32 SrcHeight, FIntPoint Dest, EXboxFrontPanelCanvasBlend Blend)
+{
+	check(Src != nullptr || SrcWidth <= 0 || SrcHeight <= 0);
+
+	const int32 MinX = FMath::Max(Dest.X, ClipRect.Min.X);
+	const int32 MinY = FMath::Max(Dest.Y, ClipRect.Min.Y);
+	const int32 MaxX = FMath::Min(Dest.X + SrcWidth, ClipRect.Max.X);
+	const int32 MaxY = FMath::Min(Dest.Y + SrcHeight, ClipRect.Max.Y);
+	if (MinX >= MaxX || MinY >= MaxY)
+	{
+		return;
+	}
+
+	const uint8* SrcRow = Src + (MinY - Dest.Y) * SrcPitch + (MinX - Dest.X);
+	uint8* DestRow = Pixels.GetData() + MinY * Pitch + MinX;
+	const int32 Count = MaxX - MinX;
+
+	// Walk bottom up when the source sits below the destination in the same buffer, so rows are read before they are
+	// overwritten.
+	const bool bBottomUp = SrcRow < DestRow && SrcRow + (MaxY - MinY) * SrcPitch > DestRow;
+	if (bBottomUp)
+	{
+		SrcRow += (MaxY - MinY - 1) * SrcPitch;
+		DestRow += (MaxY - MinY - 1) * Pitch;
+	}
+
+	for (int32 Y = MinY; Y < MaxY; ++Y)
+	{
+		XboxFrontPanelCanvas::BlendSpan(Blend, DestRow, SrcRow, Count);
+		SrcRow += bBottomUp ? -SrcPitch : SrcPitch;
+		DestRow += bBottomUp ? -Pitch : Pitch;
+	}
+}
+
+void FXboxFrontPanelCanvas::BlitCoverage(const uint8* Src, int32 SrcPitch, int32 SrcWidth, int32 SrcHeight, FIntPoint Dest, uint8 Value)
+{
+	check(Src != nullptr || SrcWidth <= 0 || SrcHeight <= 0);
+
+	const int32 MinX = FMath::Max(Dest.X, ClipRect.Min.X);
+	const int32 MinY = FMath::Max(Dest.Y, ClipRect.Min.Y);
+	const int32 MaxX = FMath::Min(Dest.X + SrcWidth, ClipRect.Max.X);
+	const int32 MaxY = FMath::Min(Dest.Y + SrcHeight, ClipRect.Max.Y);
+	if (MinX >= MaxX || MinY >= MaxY)
+	{
+		return;
+	}
+
+	const uint8* SrcRow = Src + (MinY - Dest.Y) * SrcPitch + (MinX - Dest.X);
+	uint8* DestRow = Pixels.GetData() + MinY * Pitch + MinX;
+	for (int32 Y = MinY; Y < MaxY; ++Y)
+	{
+		XboxFrontPanelCanvas::CoverageSpan(DestRow, SrcRow, MaxX - MinX, Value);
+		SrcRow += SrcPitch;
+		DestRow += Pitch;
+	}
+}
+
+void FXboxFrontPanelCanvas::Blit(const FXboxFrontPanelCanvas& Src, FIntPoint Dest, EXboxFrontPanelCanvasBlend Blend)
+{
+	Blit(Src.GetData(), Src.GetPitch(), Src.GetWidth(), Src.GetHeight(), Dest, Blend);
+}
+
+void FXboxFrontPanelCanvas::Blit(const FXboxFrontPanelCanvas& Src, const FIntRect& SrcRect, FIntPoint Dest, EXboxFrontPanelCanvasBlend Blend)
+{
+	// Keep the source rect inside the source canvas, moving the destination with any trimmed edge
+	const int32 MinX = FMath::Max(SrcRect.Min.X, 0);
+	const int32 MinY = FMath::Max(SrcRect.Min.Y, 0);
+	const int32 MaxX = FMath::Min(SrcRect.Max.X, Src.GetWidth());
+	const int32 MaxY = FMath::Min(SrcRect.Max.Y, Src.GetHeight());
+	if (MinX >= MaxX || MinY >= MaxY)
+	{
+		return;
+	}
+
+	const FIntPoint TrimmedDest(Dest.X + MinX - SrcRect.Min.X, Dest.Y + MinY - SrcRect.Min.Y);
+	Blit(Src.GetData() + MinY * Src.GetPitch() + MinX, Src.GetPitch(), MaxX - MinX, MaxY - MinY, TrimmedDest, Blend);
+}
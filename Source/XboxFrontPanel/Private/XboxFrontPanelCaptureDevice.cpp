@@ -0,0 +1,151 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelCaptureDevice.h"
+#include "XboxFrontPanelAnimation.h"
+#include "XboxFrontPanelModulePrivate.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+// How often buffered records are pushed to the file, so a crash loses little of the capture
+static const double CaptureFlushInterval = 1.0;
+
+TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> FXboxFrontPanelCaptureDevice::Create(TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> Inner, const FString& Filename)
+{
+	check(Inner.IsValid());
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogXboxFrontPanel, Warning, TEXT("Cannot write front panel capture %s."), *Filename);
+		return nullptr;
+	}
+
+	return MakeShareable(new FXboxFrontPanelCaptureDevice(Inner, Filename, MoveTemp(Writer)));
+}
+
+FXboxFrontPanelCaptureDevice::FXboxFrontPanelCaptureDevice(TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> InInner, const FString& InFilename, TUniquePtr<FArchive> InWriter)
+	: Inner(InInner)
+	, Filename(InFilename)
+	, Writer(MoveTemp(InWriter))
+	, StartTime(FPlatformTime::Seconds())
+	, LastFlushTime(StartTime)
+	, RowBytes(0)
+	, Height(0)
+	, FrameCount(0)
+	, PreviousButtons(EXboxFrontPanelButtons::None)
+	, ButtonRecordCount(0)
+{
+	// A panel without a usable screen still has buttons worth capturing
+	FXboxFrontPanelCaptureHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = XboxFrontPanelCapture::Magic;
+	Header.Version = XboxFrontPanelCapture::Version;
+
+	EXboxFrontPanelScreenFormat Format;
+	if (Inner->GetScreenInfo(Header.Width, Header.Height, Format))
+	{
+		Header.Format = static_cast<uint32>(Format);
+		Header.RowBytes = FXboxFrontPanelLuminance::GetRowBytes(Format, Header.Width);
+		RowBytes = Header.RowBytes;
+		Height = Header.Height;
+		PreviousFrame.SetNumZeroed(RowBytes * Height);
+	}
+	else
+	{
+		Header.Width = 0;
+		Header.Height = 0;
+	}
+
+	*Writer << Header;
+
+	UE_LOG(LogXboxFrontPanel, Log, TEXT("Capturing the Xbox Front Panel to %s."), *Filename);
+}
+
+FXboxFrontPanelCaptureDevice::~FXboxFrontPanelCaptureDevice()
+{
+	const int64 FileSize = Writer->Tell();
+	Writer->Close();
+	UE_LOG(LogXboxFrontPanel, Log, TEXT("Wrote front panel capture %s: %u frames, %u button changes, %lld bytes."), *Filename, FrameCount, ButtonRecordCount, FileSize);
+}
+
+void FXboxFrontPanelCaptureDevice::WriteRecordStart(EXboxFrontPanelCaptureRecord Type)
+{
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (CurrentTime - LastFlushTime >= CaptureFlushInterval)
+	{
+		Writer->Flush();
+		LastFlushTime = CurrentTime;
+	}
+
+	uint8 TypeByte = static_cast<uint8>(Type);
+	double Time = CurrentTime - StartTime;
+	*Writer << TypeByte << Time;
+}
+
+bool FXboxFrontPanelCaptureDevice::GetScreenInfo(uint32& OutWidth, uint32& OutHeight, EXboxFrontPanelScreenFormat& OutFormat)
+{
+	return Inner->GetScreenInfo(OutWidth, OutHeight, OutFormat);
+}
+
+bool FXboxFrontPanelCaptureDevice::PresentBuffer(const uint8* Data, uint32 Size)
+{
+	if (!Inner->PresentBuffer(Data, Size))
+	{
+		return false;
+	}
+
+	if (Size != RowBytes * Height || Size == 0)
+	{
+		return true;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+
+	// Only the first frame is a keyframe; replay always starts from the beginning.  Repeated frames are still
+	// written, as empty records, since the presents themselves are part of what is being compared.
+	FrameRecord.Reset();
+	FXboxFrontPanelAnimationEncoder::EncodeFrame(Data, RowBytes, PreviousFrame.GetData(), RowBytes, Height, FrameCount == 0, FrameRecord);
+
+	WriteRecordStart(EXboxFrontPanelCaptureRecord::Frame);
+	uint32 RecordSize = FrameRecord.Num();
+	*Writer << RecordSize;
+	Writer->Serialize(FrameRecord.GetData(), FrameRecord.Num());
+
+	++FrameCount;
+	return true;
+}
+
+bool FXboxFrontPanelCaptureDevice::GetButtonStates(EXboxFrontPanelButtons& OutButtons)
+{
+	if (!Inner->GetButtonStates(OutButtons))
+	{
+		return false;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	if (OutButtons != PreviousButtons)
+	{
+		WriteRecordStart(EXboxFrontPanelCaptureRecord::Buttons);
+		uint32 Buttons = static_cast<uint32>(OutButtons);
+		uint32 FrameIndex = FrameCount;
+		*Writer << Buttons << FrameIndex;
+
+		PreviousButtons = OutButtons;
+		++ButtonRecordCount;
+	}
+	return true;
+}
+
+bool FXboxFrontPanelCaptureDevice::GetLightStates(EXboxFrontPanelLights& OutLights)
+{
+	return Inner->GetLightStates(OutLights);
+}
+
+bool FXboxFrontPanelCaptureDevice::SetLightStates(EXboxFrontPanelLights Lights)
+{
+	return Inner->SetLightStates(Lights);
+}
@@ -0,0 +1,57 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "XboxFrontPanelDevice.h"
+#include "XboxFrontPanelCapture.h"
+#include "HAL/CriticalSection.h"
+
+/**
+* Wraps the device the module drives and writes every presented frame and every change in button state to a capture
+* file (see XboxFrontPanelCapture.h) as it passes through.  FXboxFrontPanelReplayDevice plays a capture back.
+*
+* Selected at startup with -XboxFrontPanelCapture=<file>.  The file is complete once the module shuts down.
+*/
+class FXboxFrontPanelCaptureDevice :
+	public IXboxFrontPanelDevice
+{
+public:
+	/** @return		A device recording Inner, or null if Filename cannot be written. */
+	static TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> Create(TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> Inner, const FString& Filename);
+
+	virtual ~FXboxFrontPanelCaptureDevice();
+
+public:
+	virtual bool GetScreenInfo(uint32& OutWidth, uint32& OutHeight, EXboxFrontPanelScreenFormat& OutFormat) override;
+	virtual bool PresentBuffer(const uint8* Data, uint32 Size) override;
+	virtual bool GetButtonStates(EXboxFrontPanelButtons& OutButtons) override;
+	virtual bool GetLightStates(EXboxFrontPanelLights& OutLights) override;
+	virtual bool SetLightStates(EXboxFrontPanelLights Lights) override;
+	virtual const TCHAR* GetName() const override { return Inner->GetName(); }
+	virtual IXboxFrontPanelDevice* GetInnerDevice() override { return Inner.Get(); }
+
+private:
+	FXboxFrontPanelCaptureDevice(TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> InInner, const FString& InFilename, TUniquePtr<FArchive> InWriter);
+
+	void WriteRecordStart(EXboxFrontPanelCaptureRecord Type);
+
+	TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> Inner;
+	FString Filename;
+
+	// Presents and button samples arrive on different threads
+	FCriticalSection Lock;
+	TUniquePtr<FArchive> Writer;
+	double StartTime;
+	double LastFlushTime;
+
+	uint32 RowBytes;
+	uint32 Height;
+	TArray<uint8> PreviousFrame;
+	TArray<uint8> FrameRecord;
+	uint32 FrameCount;
+
+	EXboxFrontPanelButtons PreviousButtons;
+	uint32 ButtonRecordCount;
+};
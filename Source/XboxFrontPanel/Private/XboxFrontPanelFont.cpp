@@ -0,0 +1,282 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelFont.h"
+#include "XboxFrontPanelModulePrivate.h"
+
+#include "Engine/TextureRenderTarget2D.h"
+#include "TextureResource.h"
+#include "Algo/BinarySearch.h"
+#include "RenderingThread.h"
+#include "Slate/WidgetRenderer.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Fonts/FontMeasure.h"
+#include "Rendering/SlateRenderer.h"
+#include "Widgets/SCanvas.h"
+#include "Widgets/Text/STextBlock.h"
+
+namespace XboxFrontPanelFont
+{
+	// The atlas matches the panel width; glyph rows are added until everything fits.
+	static const int32 PackedAtlasWidth = 256;
+
+	// Characters are rendered this many to a row of the bake target, each in a cell padded on every side to catch
+	// overhangs beyond the advance and line height.
+	static const int32 BakeColumns = 16;
+
+	struct FBakedCell
+	{
+		TCHAR Character;
+		int32 Advance;
+		int32 MinX;
+		int32 MinY;
+		int32 MaxX;
+		int32 MaxY;
+	};
+}
+
+UXboxFrontPanelFont::UXboxFrontPanelFont()
+	: AtlasWidth(0)
+	, AtlasHeight(0)
+	, LineHeight(0)
+	, Baseline(0)
+{
+#if WITH_EDITORONLY_DATA
+	// Printable ASCII
+	for (TCHAR Character = TEXT(' '); Character <= TEXT('~'); ++Character)
+	{
+		SourceCharacters.AppendChar(Character);
+	}
+#endif
+
+	BuildLookup();
+}
+
+void UXboxFrontPanelFont::PostLoad()
+{
+	Super::PostLoad();
+
+	BuildLookup();
+}
+
+#if WITH_EDITOR
+void UXboxFrontPanelFont::BakeFromSource()
+{
+	if (Bake(SourceFont, SourceCharacters))
+	{
+		MarkPackageDirty();
+	}
+}
+#endif
+
+void UXboxFrontPanelFont::BuildLookup()
+{
+	for (int16& GlyphIndex : AsciiGlyphs)
+	{
+		GlyphIndex = INDEX_NONE;
+	}
+
+	for (int32 GlyphIndex = 0; GlyphIndex < Glyphs.Num(); ++GlyphIndex)
+	{
+		const int32 Character = Glyphs[GlyphIndex].Character;
+		if (Character >= 0 && Character < ARRAY_COUNT(AsciiGlyphs))
+		{
+			AsciiGlyphs[Character] = static_cast<int16>(GlyphIndex);
+		}
+	}
+}
+
+int32 UXboxFrontPanelFont::FindGlyph(TCHAR Character) const
+{
+	const int32 Code = static_cast<int32>(Character);
+	if (Code >= 0 && Code < ARRAY_COUNT(AsciiGlyphs))
+	{
+		return AsciiGlyphs[Code];
+	}
+
+	const int32 GlyphIndex = Algo::LowerBoundBy(Glyphs, Code, [](const FXboxFrontPanelGlyph& Glyph) { return Glyph.Character; });
+	return GlyphIndex < Glyphs.Num() && Glyphs[GlyphIndex].Character == Code ? GlyphIndex : INDEX_NONE;
+}
+
+bool UXboxFrontPanelFont::Bake(const FSlateFontInfo& FontInfo, const FString& Characters)
+{
+	using namespace XboxFrontPanelFont;
+
+	check(IsInGameThread());
+
+	if (!FSlateApplication::IsInitialized() || !FontInfo.HasValidFont())
+	{
+		UE_LOG(LogXboxFrontPanel, Warning, TEXT("Cannot bake front panel font %s: %s."), *GetName(), FontInfo.HasValidFont() ? TEXT("Slate is not running") : TEXT("no font face set"));
+		return false;
+	}
+
+	TArray<TCHAR> UniqueCharacters;
+	for (TCHAR Character : Characters)
+	{
+		if (Character >= TEXT(' '))
+		{
+			UniqueCharacters.AddUnique(Character);
+		}
+	}
+	UniqueCharacters.Sort();
+
+	if (UniqueCharacters.Num() == 0)
+	{
+		return false;
+	}
+
+	// Lay the characters out one per cell, measured by Slate so advances match what an STextBlock would produce
+	const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+	const int32 FontLineHeight = FontMeasure->GetMaxCharacterHeight(FontInfo);
+	const int32 FontBaseline = FontLineHeight + FontMeasure->GetBaseline(FontInfo);
+
+	TArray<FBakedCell> Cells;
+	int32 MaxAdvance = 0;
+	for (TCHAR Character : UniqueCharacters)
+	{
+		FBakedCell& Cell = Cells.AddDefaulted_GetRef();
+		Cell.Character = Character;
+		Cell.Advance = FMath::CeilToInt(FontMeasure->Measure(FString::Chr(Character), FontInfo).X);
+		MaxAdvance = FMath::Max(MaxAdvance, Cell.Advance);
+	}
+
+	const int32 Padding = FMath::Max(FontLineHeight / 2, 1);
+	const int32 CellWidth = MaxAdvance + Padding * 2;
+	const int32 CellHeight = FontLineHeight + Padding * 2;
+	const int32 BakeRows = FMath::DivideAndRoundUp(Cells.Num(), BakeColumns);
+	const int32 BakeWidth = CellWidth * BakeColumns;
+	const int32 BakeHeight = CellHeight * BakeRows;
+
+	TSharedRef<SCanvas> BakeCanvas = SNew(SCanvas);
+	for (int32 CellIndex = 0; CellIndex < Cells.Num(); ++CellIndex)
+	{
+		BakeCanvas->AddSlot()
+			.Position(FVector2D((CellIndex % BakeColumns) * CellWidth + Padding, (CellIndex / BakeColumns) * CellHeight + Padding))
+			.Size(FVector2D(CellWidth - Padding, CellHeight - Padding))
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(FString::Chr(Cells[CellIndex].Character)))
+				.Font(FontInfo)
+				.ColorAndOpacity(FLinearColor::White)
+			];
+	}
+
+	// White on transparent black, so every color channel holds the glyph coverage
+	UTextureRenderTarget2D* BakeTarget = FWidgetRenderer::CreateTargetFor(FVector2D(BakeWidth, BakeHeight), TF_Nearest, false);
+	BakeTarget->ClearColor = FLinearColor::Transparent;
+
+	FWidgetRenderer BakeRenderer(false, true);
+	BakeRenderer.DrawWidget(BakeTarget, BakeCanvas, FVector2D(BakeWidth, BakeHeight), 0.0f);
+	FlushRenderingCommands();
+
+	TArray<FColor> BakedColors;
+	if (!BakeTarget->GameThread_GetRenderTargetResource()->ReadPixels(BakedColors) || BakedColors.Num() != BakeWidth * BakeHeight)
+	{
+		UE_LOG(LogXboxFrontPanel, Warning, TEXT("Cannot bake front panel font %s: reading the glyphs back failed."), *GetName());
+		return false;
+	}
+
+	TArray<uint8> Coverage;
+	Coverage.SetNumUninitialized(BakeWidth * BakeHeight);
+	FXboxFrontPanelLuminance::ConvertBGRA8ToR8(reinterpret_cast<const uint8*>(BakedColors.GetData()), BakeWidth * 4, Coverage.GetData(), BakeWidth, BakeWidth, BakeHeight);
+
+	// Trim each cell to the pixels the glyph actually touched
+	for (int32 CellIndex = 0; CellIndex < Cells.Num(); ++CellIndex)
+	{
+		FBakedCell& Cell = Cells[CellIndex];
+		const int32 CellX = (CellIndex % BakeColumns) * CellWidth;
+		const int32 CellY = (CellIndex / BakeColumns) * CellHeight;
+
+		Cell.MinX = CellWidth;
+		Cell.MinY = CellHeight;
+		Cell.MaxX = 0;
+		Cell.MaxY = 0;
+		for (int32 Y = 0; Y < CellHeight; ++Y)
+		{
+			const uint8* Row = Coverage.GetData() + (CellY + Y) * BakeWidth + CellX;
+			for (int32 X = 0; X < CellWidth; ++X)
+			{
+				if (Row[X] != 0)
+				{
+					Cell.MinX = FMath::Min(Cell.MinX, X);
+					Cell.MinY = FMath::Min(Cell.MinY, Y);
+					Cell.MaxX = FMath::Max(Cell.MaxX, X + 1);
+					Cell.MaxY = FMath::Max(Cell.MaxY, Y + 1);
+				}
+			}
+		}
+	}
+
+	// Shelf pack the trimmed glyphs, tallest first, into rows of the atlas
+	TArray<int32> PackOrder;
+	for (int32 CellIndex = 0; CellIndex < Cells.Num(); ++CellIndex)
+	{
+		PackOrder.Add(CellIndex);
+	}
+	PackOrder.Sort([&Cells](int32 A, int32 B) { return (Cells[A].MaxY - Cells[A].MinY) > (Cells[B].MaxY - Cells[B].MinY); });
+
+	// Built on the side so a failed bake leaves the current atlas alone
+	TArray<FXboxFrontPanelGlyph> BakedGlyphs;
+	BakedGlyphs.SetNum(Cells.Num());
+
+	int32 ShelfX = 0;
+	int32 ShelfY = 0;
+	int32 ShelfHeight = 0;
+	for (int32 CellIndex : PackOrder)
+	{
+		const FBakedCell& Cell = Cells[CellIndex];
+		const int32 GlyphWidth = FMath::Max(Cell.MaxX - Cell.MinX, 0);
+		const int32 GlyphHeight = FMath::Max(Cell.MaxY - Cell.MinY, 0);
+		if (GlyphWidth > PackedAtlasWidth || GlyphWidth > MAX_uint8 || GlyphHeight > MAX_uint8 || Cell.Advance > MAX_uint8)
+		{
+			UE_LOG(LogXboxFrontPanel, Warning, TEXT("Cannot bake front panel font %s: glyphs are too large for the panel."), *GetName());
+			return false;
+		}
+
+		if (ShelfX + GlyphWidth > PackedAtlasWidth)
+		{
+			ShelfX = 0;
+			ShelfY += ShelfHeight;
+			ShelfHeight = 0;
+		}
+
+		FXboxFrontPanelGlyph& Glyph = BakedGlyphs[CellIndex];
+		Glyph.Character = Cell.Character;
+		Glyph.AtlasX = static_cast<uint16>(ShelfX);
+		Glyph.AtlasY = static_cast<uint16>(ShelfY);
+		Glyph.Width = static_cast<uint8>(GlyphWidth);
+		Glyph.Height = static_cast<uint8>(GlyphHeight);
+		Glyph.OffsetX = static_cast<int16>(GlyphWidth > 0 ? Cell.MinX - Padding : 0);
+		Glyph.OffsetY = static_cast<int16>(GlyphHeight > 0 ? Cell.MinY - Padding : 0);
+		Glyph.Advance = static_cast<uint8>(Cell.Advance);
+
+		ShelfX += GlyphWidth;
+		ShelfHeight = FMath::Max(ShelfHeight, GlyphHeight);
+	}
+
+	Glyphs = MoveTemp(BakedGlyphs);
+	AtlasWidth = PackedAtlasWidth;
+	AtlasHeight = ShelfY + ShelfHeight;
+	LineHeight = FontLineHeight;
+	Baseline = FontBaseline;
+
+	AtlasPixels.Reset();
+	AtlasPixels.SetNumZeroed(AtlasWidth * AtlasHeight);
+	for (int32 CellIndex = 0; CellIndex < Cells.Num(); ++CellIndex)
+	{
+		const FBakedCell& Cell = Cells[CellIndex];
+		const FXboxFrontPanelGlyph& Glyph = Glyphs[CellIndex];
+		const int32 CellX = (CellIndex % BakeColumns) * CellWidth + Cell.MinX;
+		const int32 CellY = (CellIndex / BakeColumns) * CellHeight + Cell.MinY;
+		for (int32 Y = 0; Y < Glyph.Height; ++Y)
+		{
+			FMemory::Memcpy(AtlasPixels.GetData() + (Glyph.AtlasY + Y) * AtlasWidth + Glyph.AtlasX, Coverage.GetData() + (CellY + Y) * BakeWidth + CellX, Glyph.Width);
+		}
+	}
+
+	BuildLookup();
+
+	UE_LOG(LogXboxFrontPanel, Log, TEXT("Baked front panel font %s: %d glyphs, %dx%d atlas, line height %d."), *GetName(), Glyphs.Num(), AtlasWidth, AtlasHeight, LineHeight);
+	return true;
+}
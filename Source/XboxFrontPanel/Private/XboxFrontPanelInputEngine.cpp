@@ -0,0 +1,205 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelInputEngine.h"
+#include "XboxFrontPanelModule.h"
+
+#include "Framework/Application/SlateApplication.h"
+
+namespace XboxFrontPanelInput
+{
+	// Indexed by bit position in EXboxFrontPanelButtons.  Pointers, because the names themselves are initialized
+	// in another translation unit.
+	static const FGamepadKeyNames::Type* const ButtonKeyNames[FXboxFrontPanelInputConfig::NumButtons] =
+	{
+		&XboxFrontPanelKeyNames::Button1,
+		&XboxFrontPanelKeyNames::Button2,
+		&XboxFrontPanelKeyNames::Button3,
+		&XboxFrontPanelKeyNames::Button4,
+		&XboxFrontPanelKeyNames::Button5,
+		&XboxFrontPanelKeyNames::DPadLeft,
+		&XboxFrontPanelKeyNames::DPadRight,
+		&XboxFrontPanelKeyNames::DPadUp,
+		&XboxFrontPanelKeyNames::DPadDown,
+		&XboxFrontPanelKeyNames::DPadPress,
+	};
+
+	static_assert(static_cast<uint32>(EXboxFrontPanelButtons::All) == (1u << FXboxFrontPanelInputConfig::NumButtons) - 1, "ButtonKeyNames must cover every button");
+
+	static double GetRepeatInterval(const FXboxFrontPanelButtonRepeat& Repeat, int32 RepeatCount)
+	{
+		const float Scaled = Repeat.Interval * FMath::Pow(Repeat.Acceleration, static_cast<float>(RepeatCount));
+		return FMath::Max(Scaled, Repeat.MinInterval);
+	}
+}
+
+FXboxFrontPanelInputEngine::FXboxFrontPanelInputEngine()
+	: LastButtons(0)
+	, NextEventTime(MAX_dbl)
+	, ChordButtons(0)
+	, LongPressButtons(0)
+{
+	FMemory::Memzero(NextRepeatTime);
+	FMemory::Memzero(RepeatCount);
+}
+
+void FXboxFrontPanelInputEngine::SetConfig(const FXboxFrontPanelInputConfig& InConfig)
+{
+	// Release extra keys that are down, since their entries may not exist under the new config
+	for (int32 ChordIndex = 0; ChordIndex < ChordActive.Num(); ++ChordIndex)
+	{
+		if (ChordActive[ChordIndex])
+		{
+			FSlateApplication::Get().OnControllerButtonReleased(Config.Chords[ChordIndex].KeyName, 0, false);
+		}
+	}
+	for (int32 LongPressIndex = 0; LongPressIndex < LongPressActive.Num(); ++LongPressIndex)
+	{
+		if (LongPressActive[LongPressIndex])
+		{
+			FSlateApplication::Get().OnControllerButtonReleased(Config.LongPresses[LongPressIndex].KeyName, 0, false);
+		}
+	}
+
+	Config = InConfig;
+
+	ChordButtons = 0;
+	for (const FXboxFrontPanelButtonChord& Chord : Config.Chords)
+	{
+		ChordButtons |= static_cast<uint32>(Chord.Buttons);
+	}
+
+	LongPressButtons = 0;
+	for (const FXboxFrontPanelButtonLongPress& LongPress : Config.LongPresses)
+	{
+		LongPressButtons |= static_cast<uint32>(LongPress.Button);
+	}
+
+	// Anything already held starts fresh under the new rules; chords and long presses wait for their next press.
+	ChordActive.Init(false, Config.Chords.Num());
+	LongPressDueTime.Init(MAX_dbl, Config.LongPresses.Num());
+	LongPressActive.Init(false, Config.LongPresses.Num());
+	ScheduleNextEvent();
+}
+
+void FXboxFrontPanelInputEngine::Update(EXboxFrontPanelButtons Buttons, double Time)
+{
+	const uint32 NewButtons = static_cast<uint32>(Buttons & EXboxFrontPanelButtons::All);
+	const uint32 Changed = NewButtons ^ LastButtons;
+	if (Changed == 0 && Time < NextEventTime)
+	{
+		return;
+	}
+
+	FSlateApplication& SlateApp = FSlateApplication::Get();
+
+	// Presses and releases, one iteration per changed bit
+	for (uint32 Bits = Changed; Bits != 0; Bits &= Bits - 1)
+	{
+		const int32 Index = FMath::CountTrailingZeros(Bits);
+		const FGamepadKeyNames::Type& KeyName = *XboxFrontPanelInput::ButtonKeyNames[Index];
+		if (NewButtons & (1u << Index))
+		{
+			SlateApp.OnControllerButtonPressed(KeyName, 0, false);
+			NextRepeatTime[Index] = Time + Config.Repeat[Index].InitialDelay;
+			RepeatCount[Index] = 0;
+		}
+		else
+		{
+			SlateApp.OnControllerButtonReleased(KeyName, 0, false);
+		}
+	}
+
+	// Repeats for buttons that were already held
+	for (uint32 Bits = NewButtons & ~Changed; Bits != 0; Bits &= Bits - 1)
+	{
+		const int32 Index = FMath::CountTrailingZeros(Bits);
+		const FXboxFrontPanelButtonRepeat& Repeat = Config.Repeat[Index];
+		if (Repeat.Interval > 0.0f && Time >= NextRepeatTime[Index])
+		{
+			SlateApp.OnControllerButtonPressed(*XboxFrontPanelInput::ButtonKeyNames[Index], 0, true);
+			NextRepeatTime[Index] = Time + XboxFrontPanelInput::GetRepeatInterval(Repeat, RepeatCount[Index]);
+			++RepeatCount[Index];
+		}
+	}
+
+	if (Changed & ChordButtons)
+	{
+		for (int32 ChordIndex = 0; ChordIndex < Config.Chords.Num(); ++ChordIndex)
+		{
+			const FXboxFrontPanelButtonChord& Chord = Config.Chords[ChordIndex];
+			const uint32 ChordMask = static_cast<uint32>(Chord.Buttons);
+			const bool bHeld = ChordMask != 0 && (NewButtons & ChordMask) == ChordMask;
+			if (bHeld != ChordActive[ChordIndex])
+			{
+				if (bHeld)
+				{
+					SlateApp.OnControllerButtonPressed(Chord.KeyName, 0, false);
+				}
+				else
+				{
+					SlateApp.OnControllerButtonReleased(Chord.KeyName, 0, false);
+				}
+				ChordActive[ChordIndex] = bHeld;
+			}
+		}
+	}
+
+	if ((Changed | NewButtons) & LongPressButtons)
+	{
+		for (int32 LongPressIndex = 0; LongPressIndex < Config.LongPresses.Num(); ++LongPressIndex)
+		{
+			const FXboxFrontPanelButtonLongPress& LongPress = Config.LongPresses[LongPressIndex];
+			const uint32 LongPressMask = static_cast<uint32>(LongPress.Button);
+			if (Changed & LongPressMask)
+			{
+				if (NewButtons & LongPressMask)
+				{
+					LongPressDueTime[LongPressIndex] = Time + LongPress.HoldTime;
+				}
+				else
+				{
+					LongPressDueTime[LongPressIndex] = MAX_dbl;
+					if (LongPressActive[LongPressIndex])
+					{
+						SlateApp.OnControllerButtonReleased(LongPress.KeyName, 0, false);
+						LongPressActive[LongPressIndex] = false;
+					}
+				}
+			}
+
+			if (Time >= LongPressDueTime[LongPressIndex])
+			{
+				SlateApp.OnControllerButtonPressed(LongPress.KeyName, 0, false);
+				LongPressDueTime[LongPressIndex] = MAX_dbl;
+				LongPressActive[LongPressIndex] = true;
+			}
+		}
+	}
+
+	LastButtons = NewButtons;
+	ScheduleNextEvent();
+}
+
+void FXboxFrontPanelInputEngine::ScheduleNextEvent()
+{
+	NextEventTime = MAX_dbl;
+
+	for (uint32 Bits = LastButtons; Bits != 0; Bits &= Bits - 1)
+	{
+		const int32 Index = FMath::CountTrailingZeros(Bits);
+		if (Config.Repeat[Index].Interval > 0.0f)
+		{
+			NextEventTime = FMath::Min(NextEventTime, NextRepeatTime[Index]);
+		}
+	}
+
+	if (LastButtons & LongPressButtons)
+	{
+		for (double DueTime : LongPressDueTime)
+		{
+			NextEventTime = FMath::Min(NextEventTime, DueTime);
+		}
+	}
+}
@@ -0,0 +1,54 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "XboxFrontPanelInput.h"
+
+/**
+* Turns successive front panel button masks into Slate key events according to an FXboxFrontPanelInputConfig.
+*
+* Work is proportional to the buttons that changed or are held.  When the mask is unchanged and no repeat or long
+* press is due, Update returns after two compares.
+*/
+class FXboxFrontPanelInputEngine
+{
+public:
+	FXboxFrontPanelInputEngine();
+
+	void SetConfig(const FXboxFrontPanelInputConfig& InConfig);
+	const FXboxFrontPanelInputConfig& GetConfig() const { return Config; }
+
+	/**
+	* Generate events for the buttons held at Time.  Times must not go backwards.
+	*
+	* @param Time	FPlatformTime::Seconds() at which Buttons was sampled.
+	*/
+	void Update(EXboxFrontPanelButtons Buttons, double Time);
+
+	/** @return		The mask passed to the last Update. */
+	EXboxFrontPanelButtons GetButtonStates() const { return static_cast<EXboxFrontPanelButtons>(LastButtons); }
+
+private:
+	void ScheduleNextEvent();
+
+	FXboxFrontPanelInputConfig Config;
+
+	uint32 LastButtons;
+
+	// Earliest pending repeat or long press, so unchanged masks can be rejected without touching per-button state
+	double NextEventTime;
+
+	double NextRepeatTime[FXboxFrontPanelInputConfig::NumButtons];
+	int32 RepeatCount[FXboxFrontPanelInputConfig::NumButtons];
+
+	// Buttons that are part of any chord or long press, so plain edges skip those tables
+	uint32 ChordButtons;
+	uint32 LongPressButtons;
+
+	// Parallel to Config.Chords and Config.LongPresses
+	TArray<bool> ChordActive;
+	TArray<double> LongPressDueTime;
+	TArray<bool> LongPressActive;
+};
@@ -0,0 +1,57 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelKeyFilter.h"
+#include "XboxFrontPanelModule.h"
+
+FXboxFrontPanelKeyFilter::FXboxFrontPanelKeyFilter()
+	: bAcceptAll(false)
+	, KeyMask(0)
+{
+	SetConfig(FXboxFrontPanelInputConfig());
+}
+
+void FXboxFrontPanelKeyFilter::SetConfig(const FXboxFrontPanelInputConfig& Config)
+{
+	bAcceptAll = Config.KeyRouting == EXboxFrontPanelKeyRouting::AllKeys;
+	KeyMask = 0;
+	KeyNames.Reset();
+
+	AddKey(XboxFrontPanelKeyNames::Button1);
+	AddKey(XboxFrontPanelKeyNames::Button2);
+	AddKey(XboxFrontPanelKeyNames::Button3);
+	AddKey(XboxFrontPanelKeyNames::Button4);
+	AddKey(XboxFrontPanelKeyNames::Button5);
+	AddKey(XboxFrontPanelKeyNames::DPadUp);
+	AddKey(XboxFrontPanelKeyNames::DPadDown);
+	AddKey(XboxFrontPanelKeyNames::DPadLeft);
+	AddKey(XboxFrontPanelKeyNames::DPadRight);
+	AddKey(XboxFrontPanelKeyNames::DPadPress);
+
+	for (const FXboxFrontPanelButtonChord& Chord : Config.Chords)
+	{
+		AddKey(Chord.KeyName);
+	}
+	for (const FXboxFrontPanelButtonLongPress& LongPress : Config.LongPresses)
+	{
+		AddKey(LongPress.KeyName);
+	}
+
+	if (Config.KeyRouting == EXboxFrontPanelKeyRouting::PanelAndSelectedKeys)
+	{
+		for (FName KeyName : Config.RoutedKeyNames)
+		{
+			AddKey(KeyName);
+		}
+	}
+}
+
+void FXboxFrontPanelKeyFilter::AddKey(FName KeyName)
+{
+	if (!KeyName.IsNone())
+	{
+		KeyNames.AddUnique(KeyName);
+		KeyMask |= GetMaskBit(KeyName);
+	}
+}
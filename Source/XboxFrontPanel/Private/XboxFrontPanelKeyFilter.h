@@ -0,0 +1,53 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputCoreTypes.h"
+#include "XboxFrontPanelInput.h"
+
+/**
+* Decides which Slate key events the input preprocessor offers to the front panel screen widget, according to the
+* routing in an FXboxFrontPanelInputConfig.  Sees every key event the application receives, so rejecting anything
+* outside the routing costs one mask test: key names are hashed into a 64 bit mask when the config is set, and only
+* keys whose bit is set go on to compare names.
+*/
+class FXboxFrontPanelKeyFilter
+{
+public:
+	FXboxFrontPanelKeyFilter();
+
+	/** Rebuild from the routing, button keys, chords and long presses in Config.  Game thread. */
+	void SetConfig(const FXboxFrontPanelInputConfig& Config);
+
+	/** @return		True if Key should be offered to the screen widget.  Game thread. */
+	FORCEINLINE bool Accepts(const FKey& Key) const
+	{
+		if (bAcceptAll)
+		{
+			return true;
+		}
+
+		const FName KeyName = Key.GetFName();
+		if ((KeyMask & GetMaskBit(KeyName)) == 0)
+		{
+			return false;
+		}
+		return KeyNames.Contains(KeyName);
+	}
+
+private:
+	static FORCEINLINE uint64 GetMaskBit(FName KeyName)
+	{
+		return 1ull << (static_cast<uint32>(KeyName.GetComparisonIndex()) & 63);
+	}
+
+	void AddKey(FName KeyName);
+
+	bool bAcceptAll;
+	uint64 KeyMask;
+
+	// Rarely more than a couple of dozen names, so a linear search beats hashing
+	TArray<FName, TInlineAllocator<16>> KeyNames;
+};
@@ -0,0 +1,195 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelLatency.h"
+#include "XboxFrontPanelStats.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/ScopeLock.h"
+
+namespace XboxFrontPanelLatency
+{
+	// A press that has changed nothing on the panel after this long is not going to
+	static const double MaxResponseTime = 2.0;
+
+	// Menu navigation produces a few presses a second, so this covers the last minute or two of it
+	static const int32 MaxSamples = 256;
+
+	enum class ESpan : uint8
+	{
+		PressToPaint,
+		PaintToPresent,
+		PressToPresent,
+
+		Count
+	};
+
+	static const TCHAR* SpanNames[] =
+	{
+		TEXT("PressToPaint"),
+		TEXT("PaintToPresent"),
+		TEXT("PressToPresent"),
+	};
+	static_assert(ARRAY_COUNT(SpanNames) == static_cast<int32>(ESpan::Count), "Every latency span needs a name");
+
+	struct FHistory
+	{
+		FCriticalSection Lock;
+
+		// Microseconds, one per span for every press
+		FXboxFrontPanelSampleHistory Spans[static_cast<int32>(ESpan::Count)] =
+		{
+			FXboxFrontPanelSampleHistory(MaxSamples),
+			FXboxFrontPanelSampleHistory(MaxSamples),
+			FXboxFrontPanelSampleHistory(MaxSamples),
+		};
+		uint64 UnansweredCount = 0;
+	};
+
+	static FHistory& GetHistory()
+	{
+		static FHistory History;
+		return History;
+	}
+
+	static void Record(double PressTime, double PaintTime, double PresentTime)
+	{
+		const float Spans[] =
+		{
+			static_cast<float>((PaintTime - PressTime) * 1.0e6),
+			static_cast<float>((PresentTime - PaintTime) * 1.0e6),
+			static_cast<float>((PresentTime - PressTime) * 1.0e6),
+		};
+
+		FHistory& History = GetHistory();
+		FScopeLock ScopeLock(&History.Lock);
+		for (int32 Span = 0; Span < static_cast<int32>(ESpan::Count); ++Span)
+		{
+			History.Spans[Span].Add(Spans[Span]);
+		}
+	}
+}
+
+FXboxFrontPanelLatencyTracker::FXboxFrontPanelLatencyTracker()
+	: PressTime(0.0)
+	, DeliveredTime(0.0)
+	, PaintTime(0.0)
+{
+
+}
+
+void FXboxFrontPanelLatencyTracker::ExpirePress(double CurrentTime)
+{
+	if (PressTime > 0.0 && CurrentTime - PressTime > XboxFrontPanelLatency::MaxResponseTime)
+	{
+		PressTime = 0.0;
+		PaintTime = 0.0;
+
+		XboxFrontPanelLatency::FHistory& History = XboxFrontPanelLatency::GetHistory();
+		FScopeLock ScopeLock(&History.Lock);
+		++History.UnansweredCount;
+	}
+}
+
+void FXboxFrontPanelLatencyTracker::OnButtonPressed(double Time)
+{
+	const double CurrentTime = FPlatformTime::Seconds();
+
+	FScopeLock ScopeLock(&Lock);
+	ExpirePress(CurrentTime);
+	if (PressTime == 0.0)
+	{
+		PressTime = Time;
+		DeliveredTime = CurrentTime;
+		PaintTime = 0.0;
+	}
+}
+
+void FXboxFrontPanelLatencyTracker::OnScreenPainted(double Time)
+{
+	FScopeLock ScopeLock(&Lock);
+	ExpirePress(Time);
+
+	// Only a paint that started after the press reached Slate can reflect it
+	if (PressTime > 0.0 && PaintTime == 0.0 && Time >= DeliveredTime)
+	{
+		PaintTime = Time;
+	}
+}
+
+void FXboxFrontPanelLatencyTracker::OnScreenPresented(double InPaintTime, double PresentTime)
+{
+	double CompletedPressTime;
+	double CompletedPaintTime;
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		// Frames painted before the press was seen are still in flight for a while after it
+		if (PaintTime == 0.0 || InPaintTime < PaintTime)
+		{
+			return;
+		}
+
+		CompletedPressTime = PressTime;
+		CompletedPaintTime = PaintTime;
+		PressTime = 0.0;
+		PaintTime = 0.0;
+	}
+
+	XboxFrontPanelLatency::Record(CompletedPressTime, CompletedPaintTime, PresentTime);
+	CSV_CUSTOM_STAT(XboxFrontPanel, InputToPresentMs, static_cast<float>((PresentTime - CompletedPressTime) * 1000.0), ECsvCustomStatOp::Set);
+}
+
+void FXboxFrontPanelLatencyTracker::Dump(FOutputDevice& Ar)
+{
+	using namespace XboxFrontPanelLatency;
+
+	FHistory& History = GetHistory();
+
+	// Copied so that presses can keep being recorded while the spans are sorted
+	TArray<FXboxFrontPanelSampleHistory> Spans;
+	uint64 UnansweredCount;
+	{
+		FScopeLock ScopeLock(&History.Lock);
+		Spans.Append(History.Spans, ARRAY_COUNT(History.Spans));
+		UnansweredCount = History.UnansweredCount;
+	}
+
+	Ar.Logf(TEXT("Front panel input latency over the last %d of %llu presses, %llu more with no visible response (milliseconds):"), Spans[0].Num(), Spans[0].GetTotalCount(), UnansweredCount);
+	if (Spans[0].Num() == 0)
+	{
+		return;
+	}
+
+	Ar.Logf(TEXT("  %-16s %8s %8s %8s %8s %8s"), TEXT("Span"), TEXT("Min"), TEXT("Avg"), TEXT("P50"), TEXT("P99"), TEXT("Max"));
+	for (int32 Span = 0; Span < static_cast<int32>(ESpan::Count); ++Span)
+	{
+		FXboxFrontPanelSampleSummary Summary;
+		if (Spans[Span].Summarize(Summary))
+		{
+			Ar.Logf(TEXT("  %-16s %8.2f %8.2f %8.2f %8.2f %8.2f"), SpanNames[Span],
+				Summary.Min * 1.0e-3, Summary.Avg * 1.0e-3, Summary.P50 * 1.0e-3, Summary.P99 * 1.0e-3, Summary.Max * 1.0e-3);
+		}
+	}
+}
+
+void FXboxFrontPanelLatencyTracker::Reset()
+{
+	using namespace XboxFrontPanelLatency;
+
+	FHistory& History = GetHistory();
+	FScopeLock ScopeLock(&History.Lock);
+	for (int32 Span = 0; Span < static_cast<int32>(ESpan::Count); ++Span)
+	{
+		History.Spans[Span].Reset();
+	}
+	History.UnansweredCount = 0;
+}
+
+static FXboxFrontPanelDumpCommand DumpLatencyCommand(
+	TEXT("XboxFrontPanel.DumpLatency"),
+	TEXT("Logs the time from front panel button presses to the first screen frame that reflects them.  Usage: XboxFrontPanel.DumpLatency [Reset]"),
+	&FXboxFrontPanelLatencyTracker::Dump,
+	&FXboxFrontPanelLatencyTracker::Reset);
@@ -0,0 +1,52 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/**
+* Measures input-to-photon latency of the front panel screen.  A button press is followed to the first screen paint
+* after it, and then to the first present of a frame from that paint or later that actually changed the panel.  Each
+* completed press records press to paint, paint to present and press to present, which XboxFrontPanel.DumpLatency
+* summarizes.
+*
+* One press is followed at a time, so a burst of input measures its first press.  A press that changes nothing on the
+* panel within a couple of seconds is counted as having no visible response and dropped.
+*/
+class FXboxFrontPanelLatencyTracker
+{
+public:
+	FXboxFrontPanelLatencyTracker();
+
+	/** A button sampled down at Time is being passed on to Slate.  Game thread. */
+	void OnButtonPressed(double Time);
+
+	/** The screen widget was painted at Time.  Game thread. */
+	void OnScreenPainted(double Time);
+
+	/** A frame painted at PaintTime changed the panel at PresentTime.  Any thread. */
+	void OnScreenPresented(double PaintTime, double PresentTime);
+
+	/** Log min, average, median, 99th percentile and max of each span over the recent presses. */
+	static void Dump(FOutputDevice& Ar);
+
+	/** Forget every recorded press. */
+	static void Reset();
+
+private:
+	// Drops the press being followed if it has gone unanswered for too long.  Lock must be held.
+	void ExpirePress(double CurrentTime);
+
+	FCriticalSection Lock;
+
+	// Press being followed, or 0
+	double PressTime;
+
+	// When the press reached Slate, which can be well after it was sampled
+	double DeliveredTime;
+
+	// First paint after PressTime, or 0 until there is one
+	double PaintTime;
+};
@@ -0,0 +1,56 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelLightSequence.h"
+
+bool FXboxFrontPanelLightChannel::IsOn(double Elapsed) const
+{
+	if (Period <= 0.0f)
+	{
+		return DutyCycle > 0.0f;
+	}
+
+	const double Cycle = Elapsed / Period + Phase;
+	return (Cycle - FMath::FloorToDouble(Cycle)) < DutyCycle;
+}
+
+UXboxFrontPanelLightSequence::UXboxFrontPanelLightSequence()
+	: bLooping(true)
+	, Duration(0.0f)
+	, Priority(0)
+{
+}
+
+float UXboxFrontPanelLightSequence::GetPlayLength() const
+{
+	if (Duration > 0.0f)
+	{
+		return Duration;
+	}
+
+	float LongestPeriod = 0.0f;
+	for (const FXboxFrontPanelLightChannel& Channel : Channels)
+	{
+		LongestPeriod = FMath::Max(LongestPeriod, Channel.Period);
+	}
+	return LongestPeriod;
+}
+
+int32 UXboxFrontPanelLightSequence::Evaluate(double Elapsed, int32& OutCovered) const
+{
+	int32 Lights = 0;
+	OutCovered = 0;
+	for (const FXboxFrontPanelLightChannel& Channel : Channels)
+	{
+		const int32 LightBit = 1 << static_cast<int32>(Channel.Light);
+
+		// Several channels on one light combine, so a light can flash more than once per period
+		OutCovered |= LightBit;
+		if (Channel.IsOn(Elapsed))
+		{
+			Lights |= LightBit;
+		}
+	}
+	return Lights;
+}
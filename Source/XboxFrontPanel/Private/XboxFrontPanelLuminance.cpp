@@ -0,0 +1,1309 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelLuminance.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/OutputDevice.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define FRONT_PANEL_LUMINANCE_X86 1
+#else
+#define FRONT_PANEL_LUMINANCE_X86 0
+#endif
+
+#if FRONT_PANEL_LUMINANCE_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+// MSVC will emit any intrinsic regardless of the target architecture.  Clang and GCC need each
+// function that uses wider instructions to opt in, which keeps the rest of the module baseline.
+#if defined(__clang__) || defined(__GNUC__)
+#define FRONT_PANEL_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define FRONT_PANEL_TARGET_AVX2 __attribute__((target("avx2")))
+#define FRONT_PANEL_TARGET_AVX2_F16C __attribute__((target("avx2,f16c")))
+#define FRONT_PANEL_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#else
+#define FRONT_PANEL_TARGET_SSE41
+#define FRONT_PANEL_TARGET_AVX2
+#define FRONT_PANEL_TARGET_AVX2_F16C
+#define FRONT_PANEL_TARGET_AVX512
+#endif
+#endif // FRONT_PANEL_LUMINANCE_X86
+
+static TAutoConsoleVariable<int32> CVarLuminanceKernel(
+	TEXT("XboxFrontPanel.LuminanceKernel"),
+	-1,
+	TEXT("Selects the kernel used to convert the front panel screen to luminance.\n")
+	TEXT(" -1: widest kernel supported by the CPU (default)\n")
+	TEXT("  0: scalar\n")
+	TEXT("  1: SSE4.1\n")
+	TEXT("  2: AVX2\n")
+	TEXT("  3: AVX-512\n")
+	TEXT("Unsupported selections fall back to the widest supported kernel."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarMonochromeThreshold(
+	TEXT("XboxFrontPanel.MonochromeThreshold"),
+	128,
+	TEXT("Luminance at or above which a pixel is lit when converting to the thresholded 1bpp screen format (0-255)."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarLuminanceMode(
+	TEXT("XboxFrontPanel.LuminanceMode"),
+	1,
+	TEXT("Selects the arithmetic used to convert the front panel screen to luminance.\n")
+	TEXT(" 0: single precision float\n")
+	TEXT(" 1: 14 bit fixed point, bit-exact across kernels and platforms (default)"),
+	ECVF_Default);
+
+namespace XboxFrontPanelLuminance
+{
+	static const float WeightB = 0.11f;
+	static const float WeightG = 0.59f;
+	static const float WeightR = 0.3f;
+
+	// Fixed point equivalents scaled by 2^14.  They sum to exactly 1 << 14 so white stays at 255.
+	static const int32 FixedPointShift = 14;
+	static const int32 FixedPointRound = 1 << (FixedPointShift - 1);
+	static const int32 FixedWeightB = 1802;
+	static const int32 FixedWeightG = 9667;
+	static const int32 FixedWeightR = 4915;
+	static_assert(FixedWeightB + FixedWeightG + FixedWeightR == (1 << FixedPointShift), "Fixed point luminance weights must sum to one");
+
+	// 10 bit channels carry two extra bits of fraction into the shift.  White rounds up to 256, so results saturate.
+	static const int32 WideFixedPointShift = FixedPointShift + 2;
+	static const int32 WideFixedPointRound = 1 << (WideFixedPointShift - 1);
+
+	typedef void (*FConvertRowFunction)(const uint8* Src, uint8* Dest, uint32 Width);
+
+	// Weights by byte position within a pixel, so one set of 8 bit kernels serves both channel orders.  Byte 1 is
+	// always green.
+	template <EXboxFrontPanelSourceFormat Source>
+	struct TByteWeights
+	{
+		static_assert(Source == EXboxFrontPanelSourceFormat::BGRA8 || Source == EXboxFrontPanelSourceFormat::RGBA8, "Only 8 bit sources are weighted by byte");
+
+		static const bool bRedFirst = Source == EXboxFrontPanelSourceFormat::RGBA8;
+		static const int32 Fixed0 = bRedFirst ? FixedWeightR : FixedWeightB;
+		static const int32 Fixed2 = bRedFirst ? FixedWeightB : FixedWeightR;
+
+		static float Float0() { return bRedFirst ? WeightR : WeightB; }
+		static float Float2() { return bRedFirst ? WeightB : WeightR; }
+	};
+
+	template <EXboxFrontPanelSourceFormat Source>
+	static void ConvertRowFloat_Scalar(const uint8* Src, uint8* Dest, uint32 Width)
+	{
+		typedef TByteWeights<Source> FWeights;
+
+		for (uint32 X = 0; X < Width; ++X, Src += 4)
+		{
+			// Same association as the vector kernels: Byte0 + (G + Byte2)
+			const float Luminance = Src[0] * FWeights::Float0() + (Src[1] * WeightG + Src[2] * FWeights::Float2());
+			Dest[X] = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(Luminance), 0, 255));
+		}
+	}
+
+	// Reference for the fixed point kernels.  Every vector kernel must match this bit for bit.
+	template <EXboxFrontPanelSourceFormat Source>
+	static void ConvertRowFixed_Scalar(const uint8* Src, uint8* Dest, uint32 Width)
+	{
+		typedef TByteWeights<Source> FWeights;
+
+		for (uint32 X = 0; X < Width; ++X, Src += 4)
+		{
+			Dest[X] = static_cast<uint8>((Src[0] * FWeights::Fixed0 + Src[1] * FixedWeightG + Src[2] * FWeights::Fixed2 + FixedPointRound) >> FixedPointShift);
+		}
+	}
+
+	static FORCEINLINE uint32 LoadDword(const uint8* Src)
+	{
+		uint32 Value;
+		FMemory::Memcpy(&Value, Src, sizeof(Value));
+		return Value;
+	}
+
+	static void ConvertRowRGB10A2_Scalar(const uint8* Src, uint8* Dest, uint32 Width)
+	{
+		for (uint32 X = 0; X < Width; ++X, Src += 4)
+		{
+			const uint32 Pixel = LoadDword(Src);
+			const uint32 Sum = (Pixel & 0x3FF) * FixedWeightR + ((Pixel >> 10) & 0x3FF) * FixedWeightG + ((Pixel >> 20) & 0x3FF) * FixedWeightB;
+			Dest[X] = static_cast<uint8>(FMath::Min<uint32>((Sum + WideFixedPointRound) >> WideFixedPointShift, 255));
+		}
+	}
+
+	// Exact for every input, including denormals, so it agrees with the F16C conversion.
+	static FORCEINLINE float HalfToFloat(uint16 Half)
+	{
+		const uint32 Sign = static_cast<uint32>(Half & 0x8000) << 16;
+		const uint32 Exponent = (Half >> 10) & 0x1F;
+		const uint32 Mantissa = Half & 0x3FF;
+
+		if (Exponent == 0)
+		{
+			const float Denormal = Mantissa * (1.0f / 16777216.0f);
+			return Sign ? -Denormal : Denormal;
+		}
+
+		const uint32 Bits = Sign | (Exponent == 31 ? 0x7F800000 : (Exponent + 112) << 23) | (Mantissa << 13);
+		float Result;
+		FMemory::Memcpy(&Result, &Bits, sizeof(Result));
+		return Result;
+	}
+
+	// Clamps to 0-1 and rounds to 8 bits.  The comparisons are ordered like the vector max and min, so NaN becomes 0.
+	static FORCEINLINE int32 QuantizeUnitFloat(float Value)
+	{
+		Value = Value > 0.0f ? Value : 0.0f;
+		Value = Value < 1.0f ? Value : 1.0f;
+		return static_cast<int32>(Value * 255.0f + 0.5f);
+	}
+
+	static void ConvertRowFloatRGBA16_Scalar(const uint8* Src, uint8* Dest, uint32 Width)
+	{
+		for (uint32 X = 0; X < Width; ++X, Src += 8)
+		{
+			uint16 Channels[4];
+			FMemory::Memcpy(Channels, Src, sizeof(Channels));
+
+			const int32 R = QuantizeUnitFloat(HalfToFloat(Channels[0]));
+			const int32 G = QuantizeUnitFloat(HalfToFloat(Channels[1]));
+			const int32 B = QuantizeUnitFloat(HalfToFloat(Channels[2]));
+			Dest[X] = static_cast<uint8>((R * FixedWeightR + G * FixedWeightG + B * FixedWeightB + FixedPointRound) >> FixedPointShift);
+		}
+	}
+
+#if FRONT_PANEL_LUMINANCE_X86
+
+	FRONT_PANEL_TARGET_SSE41 static inline __m128 Dot3_SSE41(__m128 Src, __m128 Factor)
+	{
+		__m128 Temp = _mm_mul_ps(Src, Factor);
+		return _mm_add_ps(_mm_shuffle_ps(Temp, Temp, _MM_SHUFFLE(0, 0, 0, 0)), _mm_add_ps(_mm_shuffle_ps(Temp, Temp, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(Temp, Temp, _MM_SHUFFLE(2, 2, 2, 2))));
+	}
+
+	// Converts 8 pixels of 8 bit channels to eight 16bit luminance values.
+	FRONT_PANEL_TARGET_SSE41 static inline __m128i Convert8_SSE41(const uint8* Src, __m128 Factor)
+	{
+		const __m128i Zero = _mm_setzero_si128();
+
+		// Profiling indicates that this version is faster than a simpler version using 16 x VectorLoadByte4
+		__m128i Src0123 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + 0));
+		__m128i Src4567 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + 16));
+
+		// Unpack so each channel is 32bit and convert to float.
+		__m128 Lum0 = Dot3_SSE41(_mm_cvtepi32_ps(_mm_unpacklo_epi8(_mm_unpacklo_epi8(Src0123, Zero), Zero)), Factor);
+		__m128 Lum1 = Dot3_SSE41(_mm_cvtepi32_ps(_mm_unpackhi_epi8(_mm_unpacklo_epi8(Src0123, Zero), Zero)), Factor);
+		__m128 Lum2 = Dot3_SSE41(_mm_cvtepi32_ps(_mm_unpacklo_epi8(_mm_unpackhi_epi8(Src0123, Zero), Zero)), Factor);
+		__m128 Lum3 = Dot3_SSE41(_mm_cvtepi32_ps(_mm_unpackhi_epi8(_mm_unpackhi_epi8(Src0123, Zero), Zero)), Factor);
+		__m128 Lum4 = Dot3_SSE41(_mm_cvtepi32_ps(_mm_unpacklo_epi8(_mm_unpacklo_epi8(Src4567, Zero), Zero)), Factor);
+		__m128 Lum5 = Dot3_SSE41(_mm_cvtepi32_ps(_mm_unpackhi_epi8(_mm_unpacklo_epi8(Src4567, Zero), Zero)), Factor);
+		__m128 Lum6 = Dot3_SSE41(_mm_cvtepi32_ps(_mm_unpacklo_epi8(_mm_unpackhi_epi8(Src4567, Zero), Zero)), Factor);
+		__m128 Lum7 = Dot3_SSE41(_mm_cvtepi32_ps(_mm_unpackhi_epi8(_mm_unpackhi_epi8(Src4567, Zero), Zero)), Factor);
+
+		// Pack back down again to 16bit integer luminance per pixel
+		__m128 Lum0123 = _mm_shuffle_ps(_mm_shuffle_ps(Lum0, Lum1, 0), _mm_shuffle_ps(Lum2, Lum3, 0), _MM_SHUFFLE(2, 0, 2, 0));
+		__m128 Lum4567 = _mm_shuffle_ps(_mm_shuffle_ps(Lum4, Lum5, 0), _mm_shuffle_ps(Lum6, Lum7, 0), _MM_SHUFFLE(2, 0, 2, 0));
+
+		// Both halves round to nearest so identical inputs always produce identical outputs.
+		return _mm_packus_epi32(_mm_cvtps_epi32(Lum0123), _mm_cvtps_epi32(Lum4567));
+	}
+
+	// 16 pixels of float luminance, in two blocks of 8 for performance.
+	FRONT_PANEL_TARGET_SSE41 static inline void ConvertBlockFloat_SSE41(const uint8* Src, uint8* Dest, __m128 Factor)
+	{
+		__m128i Lum01234567 = Convert8_SSE41(Src, Factor);
+		__m128i Lum89abcdef = Convert8_SSE41(Src + 32, Factor);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest), _mm_packus_epi16(Lum01234567, Lum89abcdef));
+	}
+
+	template <EXboxFrontPanelSourceFormat Source>
+	FRONT_PANEL_TARGET_SSE41 static void ConvertRowFloat_SSE41(const uint8* Src, uint8* Dest, uint32 Width)
+	{
+		typedef TByteWeights<Source> FWeights;
+
+		if (Width < 16)
+		{
+			ConvertRowFloat_Scalar<Source>(Src, Dest, Width);
+			return;
+		}
+
+		const __m128 Factor = _mm_setr_ps(FWeights::Float0(), WeightG, FWeights::Float2(), 0.0f);
+
+		uint32 X = 0;
+		for (; X + 16 <= Width; X += 16)
+		{
+			// Operate on 16 pixels at a time in order to produce a single __m128's worth of 8bpp output.
+			ConvertBlockFloat_SSE41(Src + X * 4, Dest + X, Factor);
+		}
+
+		if (X < Width)
+		{
+			// Finish with one block ending at the last pixel.  Pixels it shares with the previous block are
+			// recomputed to the same values.
+			ConvertBlockFloat_SSE41(Src + (Width - 16) * 4, Dest + Width - 16, Factor);
+		}
+	}
+
+	// Converts 8 pixels of 8 bit channels to eight 32bit luminance values by splitting the channels out of each dword.
+	FRONT_PANEL_TARGET_AVX2 static inline __m256i Convert8_AVX2(const uint8* Src, __m256 Factor0, __m256 FactorG, __m256 Factor2)
+	{
+		const __m256i ByteMask = _mm256_set1_epi32(0xFF);
+
+		__m256i Pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Src));
+		__m256 Byte0 = _mm256_cvtepi32_ps(_mm256_and_si256(Pixels, ByteMask));
+		__m256 G = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(Pixels, 8), ByteMask));
+		__m256 Byte2 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(Pixels, 16), ByteMask));
+
+		__m256 Luminance = _mm256_add_ps(_mm256_mul_ps(Byte0, Factor0), _mm256_add_ps(_mm256_mul_ps(G, FactorG), _mm256_mul_ps(Byte2, Factor2)));
+		return _mm256_cvtps_epi32(Luminance);
+	}
+
+	// 32 pixels of float luminance.
+	FRONT_PANEL_TARGET_AVX2 static inline void ConvertBlockFloat_AVX2(const uint8* Src, uint8* Dest, __m256 Factor0, __m256 FactorG, __m256 Factor2)
+	{
+		// The 256-bit packs work within 128-bit lanes, leaving each group of four pixels one dword out of place.
+		const __m256i LaneFixup = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+		__m256i Lum0 = Convert8_AVX2(Src + 0, Factor0, FactorG, Factor2);
+		__m256i Lum1 = Convert8_AVX2(Src + 32, Factor0, FactorG, Factor2);
+		__m256i Lum2 = Convert8_AVX2(Src + 64, Factor0, FactorG, Factor2);
+		__m256i Lum3 = Convert8_AVX2(Src + 96, Factor0, FactorG, Factor2);
+
+		__m256i Packed = _mm256_packus_epi16(_mm256_packus_epi32(Lum0, Lum1), _mm256_packus_epi32(Lum2, Lum3));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(Dest), _mm256_permutevar8x32_epi32(Packed, LaneFixup));
+	}
+
+	template <EXboxFrontPanelSourceFormat Source>
+	FRONT_PANEL_TARGET_AVX2 static void ConvertRowFloat_AVX2(const uint8* Src, uint8* Dest, uint32 Width)
+	{
+		typedef TByteWeights<Source> FWeights;
+
+		if (Width < 32)
+		{
+			// Narrower kernels are always available when AVX2 is.
+			ConvertRowFloat_SSE41<Source>(Src, Dest, Width);
+			return;
+		}
+
+		const __m256 Factor0 = _mm256_set1_ps(FWeights::Float0());
+		const __m256 FactorG = _mm256_set1_ps(WeightG);
+		const __m256 Factor2 = _mm256_set1_ps(FWeights::Float2());
+
+		uint32 X = 0;
+		for (; X + 32 <= Width; X += 32)
+		{
+			ConvertBlockFloat_AVX2(Src + X * 4, Dest + X, Factor0, FactorG, Factor2);
+		}
+
+		if (X < Width)
+		{
+			ConvertBlockFloat_AVX2(Src + (Width - 32) * 4, Dest + Width - 32, Factor0, FactorG, Factor2);
+		}
+	}
+
+	FRONT_PANEL_TARGET_AVX512 static inline __m512i Convert16Float_AVX512(__m512i Pixels, __m512 Factor0, __m512 FactorG, __m512 Factor2)
+	{
+		const __m512i ByteMask = _mm512_set1_epi32(0xFF);
+
+		__m512 Byte0 = _mm512_cvtepi32_ps(_mm512_and_si512(Pixels, ByteMask));
+		__m512 G = _mm512_cvtepi32_ps(_mm512_and_si512(_mm512_srli_epi32(Pixels, 8), ByteMask));
+		__m512 Byte2 = _mm512_cvtepi32_ps(_mm512_and_si512(_mm512_srli_epi32(Pixels, 16), ByteMask));
+
+		__m512 Luminance = _mm512_add_ps(_mm512_mul_ps(Byte0, Factor0), _mm512_add_ps(_mm512_mul_ps(G, FactorG), _mm512_mul_ps(Byte2, Factor2)));
+		return _mm512_cvtps_epi32(Luminance);
+	}
+
+	template <EXboxFrontPanelSourceFormat Source>
+	FRONT_PANEL_TARGET_AVX512 static void ConvertRowFloat_AVX512(const uint8* Src, uint8* Dest, uint32 Width)
+	{
+		typedef TByteWeights<Source> FWeights;
+
+		const __m512 Factor0 = _mm512_set1_ps(FWeights::Float0());
+		const __m512 FactorG = _mm512_set1_ps(WeightG);
+		const __m512 Factor2 = _mm512_set1_ps(FWeights::Float2());
+
+		uint32 X = 0;
+		for (; X + 64 <= Width; X += 64)
+		{
+			for (uint32 Block = 0; Block < 4; ++Block)
+			{
+				__m512i Pixels = _mm512_loadu_si512(Src + (X + Block * 16) * 4);
+
+				// Saturating narrow straight to bytes, no lane fixup required.
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest + X + Block * 16), _mm512_cvtusepi32_epi8(Convert16Float_AVX512(Pixels, Factor0, FactorG, Factor2)));
+			}
+		}
+
+		// Masked loads and stores finish the row without touching anything past its end.
+		for (; X < Width; X += 16)
+		{
+			const __mmask16 Mask = static_cast<__mmask16>((1u << FMath::Min(Width - X, 16u)) - 1);
+			__m512i Pixels = _mm512_maskz_loadu_epi32(Mask, Src + X * 4);
+			_mm512_mask_cvtusepi32_storeu_epi8(Dest + X, Mask, Convert16Float_AVX512(Pixels, Factor0, FactorG, Factor2));
+		}
+	}
+
+	// Converts 4 pixels of 8 bit channels to four 32bit fixed point luminance values.  Each pixel is widened to
+	// 16bit channels so a single madd produces Byte0*W0 + G*Wg and Byte2*W2 + A*0, which hadd then folds together.
+	FRONT_PANEL_TARGET_SSE41 static inline __m128i Convert4Fixed_SSE41(const uint8* Src, __m128i Weights, __m128i Round)
+	{
+		const __m128i Zero = _mm_setzero_si128();
+
+		__m128i Pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src));
+		__m128i Sum01 = _mm_madd_epi16(_mm_unpacklo_epi8(Pixels, Zero), Weights);
+		__m128i Sum23 = _mm_madd_epi16(_mm_unpackhi_epi8(Pixels, Zero), Weights);
+		return _mm_srli_epi32(_mm_add_epi32(_mm_hadd_epi32(Sum01, Sum23), Round), FixedPointShift);
+	}
+
+	// 16 pixels of fixed point luminance.
+	FRONT_PANEL_TARGET_SSE41 static inline void ConvertBlockFixed_SSE41(const uint8* Src, uint8* Dest, __m128i Weights, __m128i Round)
+	{
+		__m128i Lum0 = Convert4Fixed_SSE41(Src + 0, Weights, Round);
+		__m128i Lum1 = Convert4Fixed_SSE41(Src + 16, Weights, Round);
+		__m128i Lum2 = Convert4Fixed_SSE41(Src + 32, Weights, Round);
+		__m128i Lum3 = Convert4Fixed_SSE41(Src + 48, Weights, Round);
+
+		// Results never exceed 255 so the signed 32 -> 16 pack cannot saturate.
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest), _mm_packus_epi16(_mm_packs_epi32(Lum0, Lum1), _mm_packs_epi32(Lum2, Lum3)));
+	}
+
+	template <EXboxFrontPanelSourceFormat Source>
+	FRONT_PANEL_TARGET_SSE41 static void ConvertRowFixed_SSE41(const uint8* Src, uint8* Dest, uint32 Width)
+	{
+		typedef TByteWeights<Source> FWeights;
+
+		if (Width < 16)
+		{
+			ConvertRowFixed_Scalar<Source>(Src, Dest, Width);
+			return;
+		}
+
+		const __m128i Weights = _mm_setr_epi16(FWeights::Fixed0, FixedWeightG, FWeights::Fixed2, 0, FWeights::Fixed0, FixedWeightG, FWeights::Fixed2, 0);
+		const __m128i Round = _mm_set1_epi32(FixedPointRound);
+
+		uint32 X = 0;
+		for (; X + 16 <= Width; X += 16)
+		{
+			ConvertBlockFixed_SSE41(Src + X * 4, Dest + X, Weights, Round);
+		}
+
+		if (X < Width)
+		{
+			ConvertBlockFixed_SSE41(Src + (Width - 16) * 4, Dest + Width - 16, Weights, Round);
+		}
+	}
+
+	FRONT_PANEL_TARGET_AVX2 static inline __m256i Convert8Fixed_AVX2(const uint8* Src, __m256i Weights, __m256i Round)
+	{
+		const __m256i Zero = _mm256_setzero_si256();
+
+		// Unpack and hadd both stay within 128-bit lanes, so pixels come out in order.
+		__m256i Pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Src));
+		__m256i SumLo = _mm256_madd_epi16(_mm256_unpacklo_epi8(Pixels, Zero), Weights);
+		__m256i SumHi = _mm256_madd_epi16(_mm256_unpackhi_epi8(Pixels, Zero), Weights);
+		return _mm256_srli_epi32(_mm256_add_epi32(_mm256_hadd_epi32(SumLo, SumHi), Round), FixedPointShift);
+	}
+
+	// 32 pixels of fixed point luminance.
+	FRONT_PANEL_TARGET_AVX2 static inline void ConvertBlockFixed_AVX2(const uint8* Src, uint8* Dest, __m256i Weights, __m256i Round)
+	{
+		const __m256i LaneFixup = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+		__m256i Lum0 = Convert8Fixed_AVX2(Src + 0, Weights, Round);
+		__m256i Lum1 = Convert8Fixed_AVX2(Src + 32, Weights, Round);
+		__m256i Lum2 = Convert8Fixed_AVX2(Src + 64, Weights, Round);
+		__m256i Lum3 = Convert8Fixed_AVX2(Src + 96, Weights, Round);
+
+		__m256i Packed = _mm256_packus_epi16(_mm256_packs_epi32(Lum0, Lum1), _mm256_packs_epi32(Lum2, Lum3));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(Dest), _mm256_permutevar8x32_epi32(Packed, LaneFixup));
+	}
+
+	template <EXboxFrontPanelSourceFormat Source>
+	FRONT_PANEL_TARGET_AVX2 static void ConvertRowFixed_AVX2(const uint8* Src, uint8* Dest, uint32 Width)
+	{
+		typedef TByteWeights<Source> FWeights;
+
+		if (Width < 32)
+		{
+			ConvertRowFixed_SSE41<Source>(Src, Dest, Width);
+			return;
+		}
+
+		const __m256i Weights = _mm256_setr_epi16(
+			FWeights::Fixed0, FixedWeightG, FWeights::Fixed2, 0, FWeights::Fixed0, FixedWeightG, FWeights::Fixed2, 0,
+			FWeights::Fixed0, FixedWeightG, FWeights::Fixed2, 0, FWeights::Fixed0, FixedWeightG, FWeights::Fixed2, 0);
+		const __m256i Round = _mm256_set1_epi32(FixedPointRound);
+
+		uint32 X = 0;
+		for (; X + 32 <= Width; X += 32)
+		{
+			ConvertBlockFixed_AVX2(Src + X * 4, Dest + X, Weights, Round);
+		}
+
+		if (X < Width)
+		{
+			ConvertBlockFixed_AVX2(Src + (Width - 32) * 4, Dest + Width - 32, Weights, Round);
+		}
+	}
+
+	// Converts 8 pixels, already zero extended to 16bit channels, to fixed point luminance.  Each qword of the
+	// result holds one pixel with its luminance in the low byte.
+	FRONT_PANEL_TARGET_AVX512 static inline __m512i Convert8Fixed_AVX512(__m256i Pixels, __m512i Weights, __m512i Round)
+	{
+		// Each qword of the madd holds [Byte0*W0 + G*Wg, Byte2*W2].  Fold the high dword into the low one.
+		__m512i Sum = _mm512_madd_epi16(_mm512_cvtepu8_epi16(Pixels), Weights);
+		Sum = _mm512_add_epi32(Sum, _mm512_srli_epi64(Sum, 32));
+		return _mm512_srli_epi32(_mm512_add_epi32(Sum, Round), FixedPointShift);
+	}
+
+	template <EXboxFrontPanelSourceFormat Source>
+	FRONT_PANEL_TARGET_AVX512 static void ConvertRowFixed_AVX512(const uint8* Src, uint8* Dest, uint32 Width)
+	{
+		typedef TByteWeights<Source> FWeights;
+
+		const __m512i Weights = _mm512_set1_epi64(static_cast<int64>(FWeights::Fixed0) | (static_cast<int64>(FixedWeightG) << 16) | (static_cast<int64>(FWeights::Fixed2) << 32));
+		const __m512i Round = _mm512_set1_epi32(FixedPointRound);
+
+		uint32 X = 0;
+		for (; X + 64 <= Width; X += 64)
+		{
+			for (uint32 Block = 0; Block < 8; ++Block)
+			{
+				__m256i Pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Src + (X + Block * 8) * 4));
+
+				// Narrow each qword straight to its low byte.
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(Dest + X + Block * 8), _mm512_cvtepi64_epi8(Convert8Fixed_AVX512(Pixels, Weights, Round)));
+			}
+		}
+
+		// Masked loads and stores finish the row without touching anything past its end.
+		for (; X < Width; X += 8)
+		{
+			const uint32 Count = FMath::Min(Width - X, 8u);
+			__m256i Pixels = _mm512_castsi512_si256(_mm512_maskz_loadu_epi8((1ull << (Count * 4)) - 1, Src + X * 4));
+			_mm512_mask_cvtepi64_storeu_epi8(Dest + X, static_cast<__mmask8>((1u << Count) - 1), Convert8Fixed_AVX512(Pixels, Weights, Round));
+		}
+	}
+
+	// Converts 4 RGB10A2 pixels to four 32bit fixed point luminance values.  Red and green are moved into the two
+	// words of each dword so one madd weighs both, and blue takes a second madd against a zero high word.
+	FRONT_PANEL_TARGET_SSE41 static inline __m128i Convert4RGB10A2_SSE41(const uint8* Src, __m128i WeightsRG, __m128i WeightsB, __m128i Round)
+	{
+		const __m128i ChannelMask = _mm_set1_epi32(0x3FF);
+		const __m128i HighChannelMask = _mm_set1_epi32(0x3FF << 16);
+
+		__m128i Pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src));
+		__m128i RG = _mm_or_si128(_mm_and_si128(Pixels, ChannelMask), _mm_and_si128(_mm_slli_epi32(Pixels, 6), HighChannelMask));
+		__m128i B = _mm_and_si128(_mm_srli_epi32(Pixels, 20), ChannelMask);
+
+		__m128i Sum = _mm_add_epi32(_mm_madd_epi16(RG, WeightsRG), _mm_madd_epi16(B, WeightsB));
+		return _mm_srli_epi32(_mm_add_epi32(Sum, Round), WideFixedPointShift);
+	}
+
+	// 16 pixels of RGB10A2 luminance.
+	FRONT_PANEL_TARGET_SSE41 static inline void ConvertBlockRGB10A2_SSE41(const uint8* Src, uint8* Dest, __m128i WeightsRG, __m128i WeightsB, __m128i Round)
+	{
+		__m128i Lum0 = Convert4RGB10A2_SSE41(Src + 0, WeightsRG, WeightsB, Round);
+		__m128i Lum1 = Convert4RGB10A2_SSE41(Src + 16, WeightsRG, WeightsB, Round);
+		__m128i Lum2 = Convert4RGB10A2_SSE41(Src + 32, WeightsRG, WeightsB, Round);
+		__m128i Lum3 = Convert4RGB10A2_SSE41(Src + 48, WeightsRG, WeightsB, Round);
+
+		// White comes out as 256, which the unsigned 16 -> 8 pack saturates.
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest), _mm_packus_epi16(_mm_packs_epi32(Lum0, Lum1), _mm_packs_epi32(Lum2, Lum3)));
+	}
+
+	FRONT_PANEL_TARGET_SSE41 static void ConvertRowRGB10A2_SSE41(const uint8* Src, uint8* Dest, uint32 Width)
+	{
+		if (Width < 16)
+		{
+			ConvertRowRGB10A2_Scalar(Src, Dest, Width);
+			return;
+		}
+
+		const __m128i WeightsRG = _mm_set1_epi32(FixedWeightR | (FixedWeightG << 16));
+		const __m128i WeightsB = _mm_set1_epi32(FixedWeightB);
+		const __m128i Round = _mm_set1_epi32(WideFixedPointRound);
+
+		uint32 X = 0;
+		for (; X + 16 <= Width; X += 16)
+		{
+			ConvertBlockRGB10A2_SSE41(Src + X * 4, Dest + X, WeightsRG, WeightsB, Round);
+		}
+
+		if (X < Width)
+		{
+			ConvertBlockRGB10A2_SSE41(Src + (Width - 16) * 4, Dest + Width - 16, WeightsRG, WeightsB, Round);
+		}
+	}
+
+	FRONT_PANEL_TARGET_AVX2 static inline __m256i Convert8RGB10A2_AVX2(const uint8* Src, __m256i WeightsRG, __m256i WeightsB, __m256i Round)
+	{
+		const __m256i ChannelMask = _mm256_set1_epi32(0x3FF);
+		const __m256i HighChannelMask = _mm256_set1_epi32(0x3FF << 16);
+
+		__m256i Pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Src));
+		__m256i RG = _mm256_or_si256(_mm256_and_si256(Pixels, ChannelMask), _mm256_and_si256(_mm256_slli_epi32(Pixels, 6), HighChannelMask));
+		__m256i B = _mm256_and_si256(_mm256_srli_epi32(Pixels, 20), ChannelMask);
+
+		__m256i Sum = _mm256_add_epi32(_mm256_madd_epi16(RG, WeightsRG), _mm256_madd_epi16(B, WeightsB));
+		return _mm256_srli_epi32(_mm256_add_epi32(Sum, Round), WideFixedPointShift);
+	}
+
+	// 32 pixels of RGB10A2 luminance.
+	FRONT_PANEL_TARGET_AVX2 static inline void ConvertBlockRGB10A2_AVX2(const uint8* Src, uint8* Dest, __m256i WeightsRG, __m256i WeightsB, __m256i Round)
+	{
+		const __m256i LaneFixup = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+		__m256i Lum0 = Convert8RGB10A2_AVX2(Src + 0, WeightsRG, WeightsB, Round);
+		__m256i Lum1 = Convert8RGB10A2_AVX2(Src + 32, WeightsRG, WeightsB, Round);
+		__m256i Lum2 = Convert8RGB10A2_AVX2(Src + 64, WeightsRG, WeightsB, Round);
+		__m256i Lum3 = Convert8RGB10A2_AVX2(Src + 96, WeightsRG, WeightsB, Round);
+
+		__m256i Packed = _mm256_packus_epi16(_mm256_packs_epi32(Lum0, Lum1), _mm256_packs_epi32(Lum2, Lum3));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(Dest), _mm256_permutevar8x32_epi32(Packed, LaneFixup));
+	}
+
+	FRONT_PANEL_TARGET_AVX2 static void ConvertRowRGB10A2_AVX2(const uint8* Src, uint8* Dest, uint32 Width)
+	{
+		if (Width < 32)
+		{
+			ConvertRowRGB10A2_SSE41(Src, Dest, Width);
+			return;
+		}
+
+		const __m256i WeightsRG = _mm256_set1_epi32(FixedWeightR | (FixedWeightG << 16));
+		const __m256i WeightsB = _mm256_set1_epi32(FixedWeightB);
+		const __m256i Round = _mm256_set1_epi32(WideFixedPointRound);
+
+		uint32 X = 0;
+		for (; X + 32 <= Width; X += 32)
+		{
+			ConvertBlockRGB10A2_AVX2(Src + X * 4, Dest + X, WeightsRG, WeightsB, Round);
+		}
+
+		if (X < Width)
+		{
+			ConvertBlockRGB10A2_AVX2(Src + (Width - 32) * 4, Dest + Width - 32, WeightsRG, WeightsB, Round);
+		}
+	}
+
+	// Rounds the eight half float channels of two pixels, clamped to 0-1, to 8 bit values in 32bit lanes.  The same
+	// steps as QuantizeUnitFloat, so the results match it exactly.
+	FRONT_PANEL_TARGET_AVX2_F16C static inline __m256i Quantize2FloatRGBA16_AVX2(const uint8* Src)
+	{
+		__m256 Values = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Src)));
+		Values = _mm256_min_ps(_mm256_max_ps(Values, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+		return _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(Values, _mm256_set1_ps(255.0f)), _mm256_set1_ps(0.5f)));
+	}
+
+	// Converts 8 FloatRGBA16 pixels to eight 32bit fixed point luminance values, in order.
+	FRONT_PANEL_TARGET_AVX2_F16C static inline __m256i Convert8FloatRGBA16_AVX2(const uint8* Src, __m256i Weights, __m256i Round)
+	{
+		// Each quantized vector holds one pixel per 128-bit lane, so the packs pair pixels 0 and 2 in the low lane
+		// with 1 and 3 in the high lane.  The madd and hadd then leave [0 2 4 6 | 1 3 5 7].
+		const __m256i Interleave = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+		__m256i Pixels0123 = _mm256_packs_epi32(Quantize2FloatRGBA16_AVX2(Src + 0), Quantize2FloatRGBA16_AVX2(Src + 16));
+		__m256i Pixels4567 = _mm256_packs_epi32(Quantize2FloatRGBA16_AVX2(Src + 32), Quantize2FloatRGBA16_AVX2(Src + 48));
+		__m256i Sum = _mm256_hadd_epi32(_mm256_madd_epi16(Pixels0123, Weights), _mm256_madd_epi16(Pixels4567, Weights));
+		return _mm256_permutevar8x32_epi32(_mm256_srli_epi32(_mm256_add_epi32(Sum, Round), FixedPointShift), Interleave);
+	}
+
+	// 16 pixels of FloatRGBA16 luminance.
+	FRONT_PANEL_TARGET_AVX2_F16C static inline void ConvertBlockFloatRGBA16_AVX2(const uint8* Src, uint8* Dest, __m256i Weights, __m256i Round)
+	{
+		__m256i Lum0 = Convert8FloatRGBA16_AVX2(Src + 0, Weights, Round);
+		__m256i Lum1 = Convert8FloatRGBA16_AVX2(Src + 64, Weights, Round);
+
+		__m128i Words0 = _mm_packs_epi32(_mm256_castsi256_si128(Lum0), _mm256_extracti128_si256(Lum0, 1));
+		__m128i Words1 = _mm_packs_epi32(_mm256_castsi256_si128(Lum1), _mm256_extracti128_si256(Lum1, 1));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Dest), _mm_packus_epi16(Words0, Words1));
+	}
+
+	FRONT_PANEL_TARGET_AVX2_F16C static void ConvertRowFloatRGBA16_AVX2(const uint8* Src, uint8* Dest, uint32 Width)
+	{
+		if (Width < 16)
+		{
+			ConvertRowFloatRGBA16_Scalar(Src, Dest, Width);
+			return;
+		}
+
+		const __m256i Weights = _mm256_setr_epi16(
+			FixedWeightR, FixedWeightG, FixedWeightB, 0, FixedWeightR, FixedWeightG, FixedWeightB, 0,
+			FixedWeightR, FixedWeightG, FixedWeightB, 0, FixedWeightR, FixedWeightG, FixedWeightB, 0);
+		const __m256i Round = _mm256_set1_epi32(FixedPointRound);
+
+		uint32 X = 0;
+		for (; X + 16 <= Width; X += 16)
+		{
+			ConvertBlockFloatRGBA16_AVX2(Src + X * 8, Dest + X, Weights, Round);
+		}
+
+		if (X < Width)
+		{
+			ConvertBlockFloatRGBA16_AVX2(Src + (Width - 16) * 8, Dest + Width - 16, Weights, Round);
+		}
+	}
+
+	static void CpuId(int32 Leaf, int32 SubLeaf, int32 Registers[4])
+	{
+#if defined(_MSC_VER)
+		__cpuidex(Registers, Leaf, SubLeaf);
+#else
+		uint32 A = 0, B = 0, C = 0, D = 0;
+		__cpuid_count(Leaf, SubLeaf, A, B, C, D);
+		Registers[0] = A;
+		Registers[1] = B;
+		Registers[2] = C;
+		Registers[3] = D;
+#endif
+	}
+
+	static uint64 ReadXCR0()
+	{
+#if defined(_MSC_VER)
+		return _xgetbv(0);
+#else
+		uint32 Low = 0, High = 0;
+		__asm__ __volatile__("xgetbv" : "=a"(Low), "=d"(High) : "c"(0));
+		return (static_cast<uint64>(High) << 32) | Low;
+#endif
+	}
+
+	static EXboxFrontPanelLuminanceKernel DetectBestKernel()
+	{
+		int32 Registers[4];
+		CpuId(0, 0, Registers);
+		const int32 MaxLeaf = Registers[0];
+
+		CpuId(1, 0, Registers);
+		const bool bSSE41 = (Registers[2] & (1 << 19)) != 0;
+		const bool bOSXSave = (Registers[2] & (1 << 27)) != 0;
+		const bool bAVX = (Registers[2] & (1 << 28)) != 0;
+
+		if (!bSSE41)
+		{
+			return EXboxFrontPanelLuminanceKernel::Scalar;
+		}
+
+		// Wider registers are only usable if the OS saves them on context switch.
+		const uint64 XCR0 = bOSXSave ? ReadXCR0() : 0;
+		const bool bOSSavesYMM = (XCR0 & 0x6) == 0x6;
+		const bool bOSSavesZMM = (XCR0 & 0xE6) == 0xE6;
+
+		if (!bAVX || !bOSSavesYMM || MaxLeaf < 7)
+		{
+			return EXboxFrontPanelLuminanceKernel::SSE41;
+		}
+
+		CpuId(7, 0, Registers);
+		const bool bAVX2 = (Registers[1] & (1 << 5)) != 0;
+		const bool bAVX512F = (Registers[1] & (1 << 16)) != 0;
+		const bool bAVX512BW = (Registers[1] & (1 << 30)) != 0;
+
+		if (bAVX512F && bAVX512BW && bAVX2 && bOSSavesZMM)
+		{
+			return EXboxFrontPanelLuminanceKernel::AVX512;
+		}
+		return bAVX2 ? EXboxFrontPanelLuminanceKernel::AVX2 : EXboxFrontPanelLuminanceKernel::SSE41;
+	}
+
+	// The half float conversions are a separate extension from AVX2, so the FloatRGBA16 kernel checks for them too.
+	static bool HasF16C()
+	{
+		static const bool bF16C = []()
+		{
+			int32 Registers[4];
+			CpuId(1, 0, Registers);
+			return (Registers[2] & (1 << 29)) != 0;
+		}();
+		return bF16C;
+	}
+
+#else
+
+	static EXboxFrontPanelLuminanceKernel DetectBestKernel()
+	{
+		return EXboxFrontPanelLuminanceKernel::Scalar;
+	}
+
+#endif // FRONT_PANEL_LUMINANCE_X86
+
+	template <EXboxFrontPanelSourceFormat Source>
+	static FConvertRowFunction GetByteRowFunction(EXboxFrontPanelLuminanceKernel Kernel, EXboxFrontPanelLuminanceMode Mode)
+	{
+		const bool bFixedPoint = Mode == EXboxFrontPanelLuminanceMode::FixedPoint;
+		switch (Kernel)
+		{
+#if FRONT_PANEL_LUMINANCE_X86
+		case EXboxFrontPanelLuminanceKernel::SSE41:
+			return bFixedPoint ? &ConvertRowFixed_SSE41<Source> : &ConvertRowFloat_SSE41<Source>;
+		case EXboxFrontPanelLuminanceKernel::AVX2:
+			return bFixedPoint ? &ConvertRowFixed_AVX2<Source> : &ConvertRowFloat_AVX2<Source>;
+		case EXboxFrontPanelLuminanceKernel::AVX512:
+			return bFixedPoint ? &ConvertRowFixed_AVX512<Source> : &ConvertRowFloat_AVX512<Source>;
+#endif
+		default:
+			return bFixedPoint ? &ConvertRowFixed_Scalar<Source> : &ConvertRowFloat_Scalar<Source>;
+		}
+	}
+
+	// Wider sources are fixed point only, and have no AVX-512 kernels since the AVX2 ones are already bound by the
+	// unpacking rather than the arithmetic.
+	static FConvertRowFunction GetRowFunction(EXboxFrontPanelSourceFormat Source, EXboxFrontPanelLuminanceKernel Kernel, EXboxFrontPanelLuminanceMode Mode)
+	{
+		switch (Source)
+		{
+		case EXboxFrontPanelSourceFormat::RGBA8:
+			return GetByteRowFunction<EXboxFrontPanelSourceFormat::RGBA8>(Kernel, Mode);
+		case EXboxFrontPanelSourceFormat::RGB10A2:
+#if FRONT_PANEL_LUMINANCE_X86
+			if (Kernel >= EXboxFrontPanelLuminanceKernel::AVX2)
+			{
+				return &ConvertRowRGB10A2_AVX2;
+			}
+			if (Kernel == EXboxFrontPanelLuminanceKernel::SSE41)
+			{
+				return &ConvertRowRGB10A2_SSE41;
+			}
+#endif
+			return &ConvertRowRGB10A2_Scalar;
+		case EXboxFrontPanelSourceFormat::FloatRGBA16:
+#if FRONT_PANEL_LUMINANCE_X86
+			if (Kernel >= EXboxFrontPanelLuminanceKernel::AVX2 && HasF16C())
+			{
+				return &ConvertRowFloatRGBA16_AVX2;
+			}
+#endif
+			return &ConvertRowFloatRGBA16_Scalar;
+		default:
+			return GetByteRowFunction<EXboxFrontPanelSourceFormat::BGRA8>(Kernel, Mode);
+		}
+	}
+
+	// Packs a row of 8bpp luminance into the destination format.  Thresholds holds one byte per column for
+	// each of the eight columns of the 1bpp dither pattern, and is unused by other formats.
+	typedef void (*FPackRowFunction)(const uint8* Luminance, uint8* Dest, uint32 Width, const uint8* Thresholds);
+
+	// Rounds 0-255 to 0-15 with the same end points as a divide by 17.
+	static FORCEINLINE uint8 QuantizeR4(uint8 Luminance)
+	{
+		return static_cast<uint8>((Luminance * 15 + 135) >> 8);
+	}
+
+	static void PackRowR4_Scalar(const uint8* Luminance, uint8* Dest, uint32 Width, const uint8* Thresholds)
+	{
+		for (uint32 X = 0; X + 1 < Width; X += 2)
+		{
+			Dest[X / 2] = static_cast<uint8>((QuantizeR4(Luminance[X]) << 4) | QuantizeR4(Luminance[X + 1]));
+		}
+
+		if (Width & 1)
+		{
+			Dest[Width / 2] = static_cast<uint8>(QuantizeR4(Luminance[Width - 1]) << 4);
+		}
+	}
+
+	static void PackRowR1_Scalar(const uint8* Luminance, uint8* Dest, uint32 Width, const uint8* Thresholds)
+	{
+		for (uint32 X = 0; X < Width; X += 8)
+		{
+			const uint32 Count = FMath::Min(Width - X, 8u);
+
+			uint8 Bits = 0;
+			for (uint32 Bit = 0; Bit < Count; ++Bit)
+			{
+				Bits |= Luminance[X + Bit] >= Thresholds[Bit] ? (0x80 >> Bit) : 0;
+			}
+			Dest[X / 8] = Bits;
+		}
+	}
+
+#if FRONT_PANEL_LUMINANCE_X86
+	FRONT_PANEL_TARGET_SSE41 static void PackRowR4_SSE41(const uint8* Luminance, uint8* Dest, uint32 Width, const uint8* Thresholds)
+	{
+		const __m128i Zero = _mm_setzero_si128();
+		const __m128i Scale = _mm_set1_epi16(15);
+		const __m128i Round = _mm_set1_epi16(135);
+
+		// Each dword pairs an even pixel in its low word with the following odd pixel, so one madd forms Even * 16 + Odd.
+		const __m128i Combine = _mm_set1_epi32(0x00010010);
+
+		uint32 X = 0;
+		for (; X + 16 <= Width; X += 16)
+		{
+			__m128i Pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Luminance + X));
+			__m128i Lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(Pixels, Zero), Scale), Round), 8);
+			__m128i Hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(Pixels, Zero), Scale), Round), 8);
+			__m128i Packed = _mm_packs_epi32(_mm_madd_epi16(Lo, Combine), _mm_madd_epi16(Hi, Combine));
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(Dest + X / 2), _mm_packus_epi16(Packed, Packed));
+		}
+
+		if (X < Width)
+		{
+			PackRowR4_Scalar(Luminance + X, Dest + X / 2, Width - X, Thresholds);
+		}
+	}
+
+	FRONT_PANEL_TARGET_SSE41 static void PackRowR1_SSE41(const uint8* Luminance, uint8* Dest, uint32 Width, const uint8* Thresholds)
+	{
+		// Reversing the pixels before movemask puts pixel 0 in bit 15, leaving the two output bytes MSB-first
+		// but swapped.
+		const __m128i Reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+		const __m128i Threshold = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(Thresholds));
+		const __m128i ReversedThreshold = _mm_shuffle_epi8(_mm_unpacklo_epi64(Threshold, Threshold), Reverse);
+
+		uint32 X = 0;
+		for (; X + 16 <= Width; X += 16)
+		{
+			__m128i Pixels = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Luminance + X)), Reverse);
+
+			// Unsigned Pixels >= Threshold, as max(Pixels, Threshold) == Pixels.
+			const uint32 Bits = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(Pixels, ReversedThreshold), Pixels));
+			Dest[X / 8] = static_cast<uint8>(Bits >> 8);
+			Dest[X / 8 + 1] = static_cast<uint8>(Bits);
+		}
+
+		if (X < Width)
+		{
+			PackRowR1_Scalar(Luminance + X, Dest + X / 8, Width - X, Thresholds);
+		}
+	}
+#endif // FRONT_PANEL_LUMINANCE_X86
+
+	static FPackRowFunction GetPackRowFunction(EXboxFrontPanelLuminanceKernel Kernel, EXboxFrontPanelScreenFormat Format)
+	{
+		const bool bOneBit = Format == EXboxFrontPanelScreenFormat::R1Threshold || Format == EXboxFrontPanelScreenFormat::R1Dithered;
+
+#if FRONT_PANEL_LUMINANCE_X86
+		// Packing is cheap next to conversion, so every vector kernel shares the SSE4.1 packers.
+		if (Kernel != EXboxFrontPanelLuminanceKernel::Scalar)
+		{
+			return bOneBit ? &PackRowR1_SSE41 : &PackRowR4_SSE41;
+		}
+#endif
+		return bOneBit ? &PackRowR1_Scalar : &PackRowR4_Scalar;
+	}
+
+	// Classic 8x8 ordered dither matrix, values 0-63.
+	static const uint8 BayerMatrix[8][8] =
+	{
+		{  0, 32,  8, 40,  2, 34, 10, 42 },
+		{ 48, 16, 56, 24, 50, 18, 58, 26 },
+		{ 12, 44,  4, 36, 14, 46,  6, 38 },
+		{ 60, 28, 52, 20, 62, 30, 54, 22 },
+		{  3, 35, 11, 43,  1, 33,  9, 41 },
+		{ 51, 19, 59, 27, 49, 17, 57, 25 },
+		{ 15, 47,  7, 39, 13, 45,  5, 37 },
+		{ 63, 31, 55, 23, 61, 29, 53, 21 },
+	};
+
+	// Luminance is converted into a stack buffer this many pixels at a time before packing.  A multiple of
+	// eight so every chunk starts on a whole destination byte and dither column.
+	static const uint32 PackChunkPixels = 256;
+
+	static void GetRowThresholds(EXboxFrontPanelScreenFormat Format, uint32 Row, uint8 (&OutThresholds)[8])
+	{
+		const uint8 Threshold = static_cast<uint8>(FMath::Clamp(CVarMonochromeThreshold.GetValueOnAnyThread(), 0, 255));
+		for (uint32 Column = 0; Column < 8; ++Column)
+		{
+			// Spread the 64 dither levels across 2-254 so black stays black and white stays white.
+			OutThresholds[Column] = Format == EXboxFrontPanelScreenFormat::R1Dithered ? static_cast<uint8>(BayerMatrix[Row & 7][Column] * 4 + 2) : Threshold;
+		}
+	}
+}
+
+void FXboxFrontPanelLuminance::ConvertBGRA8ToR8(const uint8* Src, uint32 SrcPitch, uint8* Dest, uint32 DestPitch, uint32 Width, uint32 Height)
+{
+	ConvertBGRA8ToR8(GetActiveKernel(), GetActiveMode(), Src, SrcPitch, Dest, DestPitch, Width, Height);
+}
+
+void FXboxFrontPanelLuminance::ConvertBGRA8ToR8(EXboxFrontPanelLuminanceKernel Kernel, EXboxFrontPanelLuminanceMode Mode, const uint8* Src, uint32 SrcPitch, uint8* Dest, uint32 DestPitch, uint32 Width, uint32 Height)
+{
+	Convert(EXboxFrontPanelSourceFormat::BGRA8, EXboxFrontPanelScreenFormat::R8, Kernel, Mode, Src, SrcPitch, Dest, DestPitch, Width, Height);
+}
+
+void FXboxFrontPanelLuminance::ConvertBGRA8(EXboxFrontPanelScreenFormat Format, const uint8* Src, uint32 SrcPitch, uint8* Dest, uint32 DestPitch, uint32 Width, uint32 Height, uint32 FirstRow)
+{
+	Convert(EXboxFrontPanelSourceFormat::BGRA8, Format, GetActiveKernel(), GetActiveMode(), Src, SrcPitch, Dest, DestPitch, Width, Height, FirstRow);
+}
+
+void FXboxFrontPanelLuminance::ConvertBGRA8(EXboxFrontPanelScreenFormat Format, EXboxFrontPanelLuminanceKernel Kernel, EXboxFrontPanelLuminanceMode Mode, const uint8* Src, uint32 SrcPitch, uint8* Dest, uint32 DestPitch, uint32 Width, uint32 Height, uint32 FirstRow)
+{
+	Convert(EXboxFrontPanelSourceFormat::BGRA8, Format, Kernel, Mode, Src, SrcPitch, Dest, DestPitch, Width, Height, FirstRow);
+}
+
+void FXboxFrontPanelLuminance::Convert(EXboxFrontPanelSourceFormat Source, EXboxFrontPanelScreenFormat Format, const uint8* Src, uint32 SrcPitch, uint8* Dest, uint32 DestPitch, uint32 Width, uint32 Height, uint32 FirstRow)
+{
+	Convert(Source, Format, GetActiveKernel(), GetActiveMode(), Src, SrcPitch, Dest, DestPitch, Width, Height, FirstRow);
+}
+
+void FXboxFrontPanelLuminance::Convert(EXboxFrontPanelSourceFormat Source, EXboxFrontPanelScreenFormat Format, EXboxFrontPanelLuminanceKernel Kernel, EXboxFrontPanelLuminanceMode Mode, const uint8* Src, uint32 SrcPitch, uint8* Dest, uint32 DestPitch, uint32 Width, uint32 Height, uint32 FirstRow)
+{
+	using namespace XboxFrontPanelLuminance;
+
+	check(IsKernelSupported(Kernel));
+
+	const FConvertRowFunction ConvertRow = GetRowFunction(Source, Kernel, Mode);
+	if (Format == EXboxFrontPanelScreenFormat::R8)
+	{
+		for (uint32 Row = 0; Row < Height; ++Row)
+		{
+			ConvertRow(Src, Dest, Width);
+			Src += SrcPitch;
+			Dest += DestPitch;
+		}
+		return;
+	}
+
+	const FPackRowFunction PackRow = GetPackRowFunction(Kernel, Format);
+	const uint32 PixelsPerByte = Format == EXboxFrontPanelScreenFormat::R4 ? 2 : 8;
+	const uint32 BytesPerPixel = GetSourceBytesPerPixel(Source);
+
+	// Each chunk of luminance is packed while it is still in L1, so the deeper formats cost one extra pass over a
+	// few hundred bytes rather than over the surface.
+	uint8 Luminance[PackChunkPixels];
+	uint8 Thresholds[8];
+	for (uint32 Row = 0; Row < Height; ++Row)
+	{
+		GetRowThresholds(Format, FirstRow + Row, Thresholds);
+
+		for (uint32 X = 0; X < Width; X += PackChunkPixels)
+		{
+			const uint32 Count = FMath::Min(Width - X, PackChunkPixels);
+			ConvertRow(Src + X * BytesPerPixel, Luminance, Count);
+			PackRow(Luminance, Dest + X / PixelsPerByte, Count, Thresholds);
+		}
+
+		Src += SrcPitch;
+		Dest += DestPitch;
+	}
+}
+
+void FXboxFrontPanelLuminance::PackR8(EXboxFrontPanelScreenFormat Format, const uint8* Src, uint32 SrcPitch, uint8* Dest, uint32 DestPitch, uint32 Width, uint32 Height, uint32 FirstRow)
+{
+	using namespace XboxFrontPanelLuminance;
+
+	if (Format == EXboxFrontPanelScreenFormat::R8)
+	{
+		for (uint32 Row = 0; Row < Height; ++Row)
+		{
+			FMemory::Memcpy(Dest + Row * DestPitch, Src + Row * SrcPitch, Width);
+		}
+		return;
+	}
+
+	const EXboxFrontPanelLuminanceKernel Kernel = GetActiveKernel();
+	const FPackRowFunction PackRow = GetPackRowFunction(Kernel, Format);
+
+	uint8 Thresholds[8];
+	for (uint32 Row = 0; Row < Height; ++Row)
+	{
+		GetRowThresholds(Format, FirstRow + Row, Thresholds);
+		PackRow(Src, Dest, Width, Thresholds);
+
+		Src += SrcPitch;
+		Dest += DestPitch;
+	}
+}
+
+void FXboxFrontPanelLuminance::UnpackR8(EXboxFrontPanelScreenFormat Format, const uint8* Src, uint32 SrcPitch, uint8* Dest, uint32 DestPitch, uint32 Width, uint32 Height)
+{
+	for (uint32 Row = 0; Row < Height; ++Row)
+	{
+		const uint8* SrcRow = Src + Row * SrcPitch;
+		uint8* DestRow = Dest + Row * DestPitch;
+		switch (Format)
+		{
+		case EXboxFrontPanelScreenFormat::R4:
+			for (uint32 X = 0; X < Width; ++X)
+			{
+				DestRow[X] = static_cast<uint8>(((SrcRow[X / 2] >> ((X & 1) ? 0 : 4)) & 0xF) * 17);
+			}
+			break;
+		case EXboxFrontPanelScreenFormat::R1Threshold:
+		case EXboxFrontPanelScreenFormat::R1Dithered:
+			for (uint32 X = 0; X < Width; ++X)
+			{
+				DestRow[X] = (SrcRow[X / 8] & (0x80 >> (X & 7))) ? 255 : 0;
+			}
+			break;
+		default:
+			FMemory::Memcpy(DestRow, SrcRow, Width);
+			break;
+		}
+	}
+}
+
+uint32 FXboxFrontPanelLuminance::GetRowBytes(EXboxFrontPanelScreenFormat Format, uint32 Width)
+{
+	switch (Format)
+	{
+	case EXboxFrontPanelScreenFormat::R4:
+		return (Width + 1) / 2;
+	case EXboxFrontPanelScreenFormat::R1Threshold:
+	case EXboxFrontPanelScreenFormat::R1Dithered:
+		return (Width + 7) / 8;
+	default:
+		return Width;
+	}
+}
+
+const TCHAR* FXboxFrontPanelLuminance::GetFormatName(EXboxFrontPanelScreenFormat Format)
+{
+	switch (Format)
+	{
+	case EXboxFrontPanelScreenFormat::R8:
+		return TEXT("R8");
+	case EXboxFrontPanelScreenFormat::R4:
+		return TEXT("R4");
+	case EXboxFrontPanelScreenFormat::R1Threshold:
+		return TEXT("R1 threshold");
+	case EXboxFrontPanelScreenFormat::R1Dithered:
+		return TEXT("R1 dithered");
+	default:
+		return TEXT("Unknown");
+	}
+}
+
+uint32 FXboxFrontPanelLuminance::GetSourceBytesPerPixel(EXboxFrontPanelSourceFormat Source)
+{
+	return Source == EXboxFrontPanelSourceFormat::FloatRGBA16 ? 8 : 4;
+}
+
+const TCHAR* FXboxFrontPanelLuminance::GetSourceFormatName(EXboxFrontPanelSourceFormat Source)
+{
+	switch (Source)
+	{
+	case EXboxFrontPanelSourceFormat::BGRA8:
+		return TEXT("BGRA8");
+	case EXboxFrontPanelSourceFormat::RGBA8:
+		return TEXT("RGBA8");
+	case EXboxFrontPanelSourceFormat::RGB10A2:
+		return TEXT("RGB10A2");
+	case EXboxFrontPanelSourceFormat::FloatRGBA16:
+		return TEXT("FloatRGBA16");
+	default:
+		return TEXT("Unknown");
+	}
+}
+
+bool FXboxFrontPanelLuminance::IsKernelSupported(EXboxFrontPanelLuminanceKernel Kernel)
+{
+	return Kernel < EXboxFrontPanelLuminanceKernel::Count && Kernel <= GetBestKernel();
+}
+
+EXboxFrontPanelLuminanceKernel FXboxFrontPanelLuminance::GetBestKernel()
+{
+	static const EXboxFrontPanelLuminanceKernel BestKernel = XboxFrontPanelLuminance::DetectBestKernel();
+	return BestKernel;
+}
+
+EXboxFrontPanelLuminanceKernel FXboxFrontPanelLuminance::GetActiveKernel()
+{
+	const int32 Requested = CVarLuminanceKernel.GetValueOnAnyThread();
+	if (Requested >= 0 && IsKernelSupported(static_cast<EXboxFrontPanelLuminanceKernel>(Requested)))
+	{
+		return static_cast<EXboxFrontPanelLuminanceKernel>(Requested);
+	}
+	return GetBestKernel();
+}
+
+EXboxFrontPanelLuminanceMode FXboxFrontPanelLuminance::GetActiveMode()
+{
+	return CVarLuminanceMode.GetValueOnAnyThread() == 0 ? EXboxFrontPanelLuminanceMode::Float : EXboxFrontPanelLuminanceMode::FixedPoint;
+}
+
+uint32 FXboxFrontPanelLuminance::GetPixelsPerIteration(EXboxFrontPanelLuminanceKernel Kernel)
+{
+	switch (Kernel)
+	{
+	case EXboxFrontPanelLuminanceKernel::SSE41:
+		return 16;
+	case EXboxFrontPanelLuminanceKernel::AVX2:
+		return 32;
+	case EXboxFrontPanelLuminanceKernel::AVX512:
+		return 64;
+	default:
+		return 1;
+	}
+}
+
+const TCHAR* FXboxFrontPanelLuminance::GetKernelName(EXboxFrontPanelLuminanceKernel Kernel)
+{
+	switch (Kernel)
+	{
+	case EXboxFrontPanelLuminanceKernel::Scalar:
+		return TEXT("Scalar");
+	case EXboxFrontPanelLuminanceKernel::SSE41:
+		return TEXT("SSE4.1");
+	case EXboxFrontPanelLuminanceKernel::AVX2:
+		return TEXT("AVX2");
+	case EXboxFrontPanelLuminanceKernel::AVX512:
+		return TEXT("AVX-512");
+	default:
+		return TEXT("Unknown");
+	}
+}
+
+static void BenchmarkLuminanceKernels(const TArray<FString>& Args, FOutputDevice& Ar)
+{
+	const uint32 Width = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 256;
+	const uint32 Height = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 64;
+	const int32 Iterations = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 1000;
+	if (Width == 0 || Height == 0 || Iterations <= 0)
+	{
+		Ar.Logf(TEXT("Usage: XboxFrontPanel.BenchmarkLuminance [Width] [Height] [Iterations]"));
+		return;
+	}
+
+	// Sized for the widest source format; narrower ones read the start of it.
+	TArray<uint8> Src;
+	Src.SetNumUninitialized(Width * Height * 8);
+	for (int32 Index = 0; Index < Src.Num(); ++Index)
+	{
+		Src[Index] = static_cast<uint8>(Index * 131 + (Index >> 8));
+	}
+
+	TArray<uint8> Dest;
+	Dest.SetNumUninitialized(Width * Height);
+
+	Ar.Logf(TEXT("Luminance kernels, %ux%u, %d iterations (best supported: %s):"), Width, Height, Iterations, FXboxFrontPanelLuminance::GetKernelName(FXboxFrontPanelLuminance::GetBestKernel()));
+	for (uint8 KernelIndex = 0; KernelIndex < static_cast<uint8>(EXboxFrontPanelLuminanceKernel::Count); ++KernelIndex)
+	{
+		const EXboxFrontPanelLuminanceKernel Kernel = static_cast<EXboxFrontPanelLuminanceKernel>(KernelIndex);
+		if (!FXboxFrontPanelLuminance::IsKernelSupported(Kernel))
+		{
+			continue;
+		}
+
+		for (uint8 SourceIndex = 0; SourceIndex < static_cast<uint8>(EXboxFrontPanelSourceFormat::Count); ++SourceIndex)
+		{
+			const EXboxFrontPanelSourceFormat Source = static_cast<EXboxFrontPanelSourceFormat>(SourceIndex);
+			const uint32 SrcPitch = Width * FXboxFrontPanelLuminance::GetSourceBytesPerPixel(Source);
+
+			for (EXboxFrontPanelLuminanceMode Mode : { EXboxFrontPanelLuminanceMode::Float, EXboxFrontPanelLuminanceMode::FixedPoint })
+			{
+				// Only 8 bit sources have a float path
+				if (Mode == EXboxFrontPanelLuminanceMode::Float && Source != EXboxFrontPanelSourceFormat::BGRA8 && Source != EXboxFrontPanelSourceFormat::RGBA8)
+				{
+					continue;
+				}
+
+				const double StartTime = FPlatformTime::Seconds();
+				for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+				{
+					FXboxFrontPanelLuminance::Convert(Source, EXboxFrontPanelScreenFormat::R8, Kernel, Mode, Src.GetData(), SrcPitch, Dest.GetData(), Width, Width, Height);
+				}
+				const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+				Ar.Logf(TEXT("  %-8s %-11s %-5s %8.2f us/frame  %6.2f ns/pixel"), FXboxFrontPanelLuminance::GetKernelName(Kernel), FXboxFrontPanelLuminance::GetSourceFormatName(Source),
+					Mode == EXboxFrontPanelLuminanceMode::Float ? TEXT("float") : TEXT("fixed"), Elapsed * 1.0e6 / Iterations, Elapsed * 1.0e9 / (double(Iterations) * Width * Height));
+			}
+		}
+	}
+}
+
+// Fills Src with a verification surface for the given source format and returns its width in pixels.
+static uint32 FillLuminanceVerifySource(EXboxFrontPanelSourceFormat Source, TArray<uint8>& Src)
+{
+	const uint32 Pixels = static_cast<uint32>(Src.Num()) / FXboxFrontPanelLuminance::GetSourceBytesPerPixel(Source);
+	switch (Source)
+	{
+	case EXboxFrontPanelSourceFormat::RGB10A2:
+		// Too many inputs to cover, so a bijective hash spreads every pixel to a different pattern, alpha included.
+		for (uint32 Index = 0; Index < Pixels; ++Index)
+		{
+			const uint32 Pixel = Index * 2654435761u;
+			FMemory::Memcpy(Src.GetData() + Index * 4, &Pixel, sizeof(Pixel));
+		}
+		break;
+
+	case EXboxFrontPanelSourceFormat::FloatRGBA16:
+		// Every half float bit pattern, denormals, infinities and NaNs included, lands in every channel.
+		for (uint32 Index = 0; Index < Pixels * 4; ++Index)
+		{
+			const uint16 Half = static_cast<uint16>(Index * 40503u + (Index >> 16));
+			FMemory::Memcpy(Src.GetData() + Index * 2, &Half, sizeof(Half));
+		}
+		break;
+
+	default:
+		// Every 24bit colour, with a varying alpha that must be ignored.
+		for (uint32 Color = 0; Color < Pixels; ++Color)
+		{
+			Src[Color * 4 + 0] = static_cast<uint8>(Color);
+			Src[Color * 4 + 1] = static_cast<uint8>(Color >> 8);
+			Src[Color * 4 + 2] = static_cast<uint8>(Color >> 16);
+			Src[Color * 4 + 3] = static_cast<uint8>(Color * 7);
+		}
+		break;
+	}
+	return Pixels / 4096;
+}
+
+static void VerifyLuminanceKernels(const TArray<FString>& Args, FOutputDevice& Ar)
+{
+	// 4096 rows of 16KB, which holds all 2^24 colours for the 8 bit sources.
+	const uint32 Height = 4096;
+
+	TArray<uint8> Src;
+	Src.SetNumUninitialized(16384 * Height);
+
+	TArray<uint8> Reference;
+	TArray<uint8> Dest;
+	for (uint8 SourceIndex = 0; SourceIndex < static_cast<uint8>(EXboxFrontPanelSourceFormat::Count); ++SourceIndex)
+	{
+		const EXboxFrontPanelSourceFormat Source = static_cast<EXboxFrontPanelSourceFormat>(SourceIndex);
+		const uint32 Width = FillLuminanceVerifySource(Source, Src);
+		const uint32 SrcPitch = Width * FXboxFrontPanelLuminance::GetSourceBytesPerPixel(Source);
+
+		Reference.SetNumUninitialized(Width * Height);
+		Dest.SetNumUninitialized(Width * Height);
+		FXboxFrontPanelLuminance::Convert(Source, EXboxFrontPanelScreenFormat::R8, EXboxFrontPanelLuminanceKernel::Scalar, EXboxFrontPanelLuminanceMode::FixedPoint, Src.GetData(), SrcPitch, Reference.GetData(), Width, Width, Height);
+
+		Ar.Logf(TEXT("%s:"), FXboxFrontPanelLuminance::GetSourceFormatName(Source));
+		for (uint8 KernelIndex = 1; KernelIndex < static_cast<uint8>(EXboxFrontPanelLuminanceKernel::Count); ++KernelIndex)
+		{
+			const EXboxFrontPanelLuminanceKernel Kernel = static_cast<EXboxFrontPanelLuminanceKernel>(KernelIndex);
+			if (!FXboxFrontPanelLuminance::IsKernelSupported(Kernel))
+			{
+				Ar.Logf(TEXT("  %-8s not supported"), FXboxFrontPanelLuminance::GetKernelName(Kernel));
+				continue;
+			}
+
+			FXboxFrontPanelLuminance::Convert(Source, EXboxFrontPanelScreenFormat::R8, Kernel, EXboxFrontPanelLuminanceMode::FixedPoint, Src.GetData(), SrcPitch, Dest.GetData(), Width, Width, Height);
+
+			uint32 Mismatches = 0;
+			for (uint32 Pixel = 0; Pixel < Width * Height; ++Pixel)
+			{
+				if (Dest[Pixel] != Reference[Pixel])
+				{
+					if (Mismatches++ == 0)
+					{
+						Ar.Logf(TEXT("  %-8s first mismatch at pixel 0x%06X: %u, expected %u"), FXboxFrontPanelLuminance::GetKernelName(Kernel), Pixel, Dest[Pixel], Reference[Pixel]);
+					}
+				}
+			}
+			Ar.Logf(TEXT("  %-8s %s (%u mismatches)"), FXboxFrontPanelLuminance::GetKernelName(Kernel), Mismatches == 0 ? TEXT("PASSED") : TEXT("FAILED"), Mismatches);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice BenchmarkLuminanceKernelsCommand(
+	TEXT("XboxFrontPanel.BenchmarkLuminance"),
+	TEXT("Times every supported front panel luminance kernel.  Usage: XboxFrontPanel.BenchmarkLuminance [Width] [Height] [Iterations]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld*, FOutputDevice& Ar) { BenchmarkLuminanceKernels(Args, Ar); }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice VerifyLuminanceKernelsCommand(
+	TEXT("XboxFrontPanel.VerifyLuminance"),
+	TEXT("Checks every supported fixed point luminance kernel against the scalar reference, for all 2^24 RGB inputs of the 8 bit sources and a spread of the wider ones."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld*, FOutputDevice& Ar) { VerifyLuminanceKernels(Args, Ar); }));
@@ -4,410 +4,1446 @@
 
 #include "XboxFrontPanelModule.h"
 #include "XboxFrontPanelModulePrivate.h"
+#include "XboxFrontPanelSimulatedDevice.h"
+#include "XboxFrontPanelCaptureDevice.h"
+#include "XboxFrontPanelReplayDevice.h"
+#include "XboxFrontPanelSharedMemoryDevice.h"
+#include "XboxFrontPanelXdkDevice.h"
+#include "XboxFrontPanelLightSequence.h"
 
 #if FRONT_PANEL_ENABLED
 
 #include "PixelFormat.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "TextureResource.h"
+#include "RenderingThread.h"
 #include "Widgets/SWidget.h"
+#include "Widgets/SNullWidget.h"
 #include "Blueprint/UserWidget.h"
 #include "Slate/SRetainerWidget.h"
 #include "ScopeLock.h"
 #include "Framework/Application/SlateApplication.h"
-#include "UnrealMathDirectX.h"
 #include "SceneUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
 
+#if PLATFORM_XBOXONE
 #include "XboxOneAllowPlatformTypes.h"
 #include <d3d12_x.h>
+#include "XboxOneHidePlatformTypes.h"
+#endif
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Frames Presented"), STAT_XboxFrontPanel_FramesPresented, STATGROUP_XboxFrontPanel);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Frames Skipped (Unchanged)"), STAT_XboxFrontPanel_FramesSkipped, STATGROUP_XboxFrontPanel);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Rows Converted"), STAT_XboxFrontPanel_RowsConverted, STATGROUP_XboxFrontPanel);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Rows Skipped (Unchanged)"), STAT_XboxFrontPanel_RowsSkipped, STATGROUP_XboxFrontPanel);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Readback Stalls (Not Ready)"), STAT_XboxFrontPanel_ReadbacksNotReady, STATGROUP_XboxFrontPanel);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Readbacks Superseded"), STAT_XboxFrontPanel_ReadbacksSuperseded, STATGROUP_XboxFrontPanel);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Frames Dropped (Ring Full)"), STAT_XboxFrontPanel_FramesDropped, STATGROUP_XboxFrontPanel);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Async Frames Deferred (Pool Empty)"), STAT_XboxFrontPanel_AsyncFramesDeferred, STATGROUP_XboxFrontPanel);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Readbacks In Flight"), STAT_XboxFrontPanel_ReadbacksInFlight, STATGROUP_XboxFrontPanel);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Low Latency Readbacks Waited"), STAT_XboxFrontPanel_LowLatencyReadbacks, STATGROUP_XboxFrontPanel);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Low Latency Waits Timed Out"), STAT_XboxFrontPanel_LowLatencyTimeouts, STATGROUP_XboxFrontPanel);
+
+static TAutoConsoleVariable<int32> CVarSimulate(
+	TEXT("XboxFrontPanel.Simulate"),
+	0,
+	TEXT("When non-zero and no front panel is present, drive an in-process simulated panel instead.  See XboxFrontPanel.Sim.*.\n")
+	TEXT("Read at startup; -XboxFrontPanelSim on the command line does the same."),
+	ECVF_ReadOnly);
+
+static TAutoConsoleVariable<int32> CVarSkipUnchangedRows(
+	TEXT("XboxFrontPanel.SkipUnchangedRows"),
+	1,
+	TEXT("When non-zero, only rows of the front panel screen that changed since the previous frame are converted,\n")
+	TEXT("and the present is skipped entirely when nothing changed."),
+	ECVF_RenderThreadSafe);
+
+static const int32 MaxReadbackDepth = 8;
+
+static TAutoConsoleVariable<int32> CVarReadbackDepth(
+	TEXT("XboxFrontPanel.ReadbackDepth"),
+	2,
+	TEXT("Number of staging surfaces used to read the front panel screen back from the GPU (1-8).\n")
+	TEXT("A surface is only mapped once its GPU fence has signaled.  When every surface is in flight new frames are\n")
+	TEXT("dropped rather than waited on, so deeper rings trade latency for fewer drops."),
+	ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<int32> CVarAsyncPresent(
+	TEXT("XboxFrontPanel.AsyncPresent"),
+	0,
+	TEXT("When non-zero, luminance conversion and PresentBuffer run on a dedicated low priority thread.  The render thread\n")
+	TEXT("only copies the mapped staging surface into a pooled buffer.  Takes effect when screen resources are next created."),
+	ECVF_RenderThreadSafe);
+
+static const int32 AsyncPresentFrameCount = 3;
+
+static TAutoConsoleVariable<int32> CVarLowLatency(
+	TEXT("XboxFrontPanel.LowLatency"),
+	0,
+	TEXT("When non-zero, front panel input is handled before the screen is painted, so a press shows in that tick's paint,\n")
+	TEXT("and the render thread waits up to XboxFrontPanel.LowLatencyWaitTime for each readback so the paint reaches the\n")
+	TEXT("panel in the frame it was made rather than the next.  Costs a flush to the RHI thread for every painted frame.\n")
+	TEXT("See XboxFrontPanel.DumpLatency for the effect."),
+	ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<float> CVarLowLatencyWaitTime(
+	TEXT("XboxFrontPanel.LowLatencyWaitTime"),
+	2.0f,
+	TEXT("In XboxFrontPanel.LowLatency, the longest time in milliseconds the render thread waits on a front panel readback.\n")
+	TEXT("Readbacks that take longer are presented the next frame as usual."),
+	ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<int32> CVarRedrawMode(
+	TEXT("XboxFrontPanel.RedrawMode"),
+	0,
+	TEXT("Controls when the front panel screen widget is painted.\n")
+	TEXT(" 0: every tick (default)\n")
+	TEXT(" 1: only after the screen is invalidated, by a new widget, handled panel input, a playing UMG animation,\n")
+	TEXT("    MarkScreenDirty, or XboxFrontPanel.MaxRedrawInterval elapsing.  Otherwise the last presented frame is kept."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarMaxRedrawInterval(
+	TEXT("XboxFrontPanel.MaxRedrawInterval"),
+	0.5f,
+	TEXT("In XboxFrontPanel.RedrawMode 1, the longest time in seconds between paints of the front panel screen.\n")
+	TEXT("Catches changes that do not invalidate the screen, such as UMG property bindings.  0 disables."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarMonochromeDither(
+	TEXT("XboxFrontPanel.MonochromeDither"),
+	1,
+	TEXT("How luminance is reduced to one bit per pixel on 1bpp front panel screens.  Read when the screen is initialized.\n")
+	TEXT(" 0: threshold against XboxFrontPanel.MonochromeThreshold\n")
+	TEXT(" 1: 8x8 ordered dither (default)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarScreenSourceFormat(
+	TEXT("XboxFrontPanel.ScreenSourceFormat"),
+	0,
+	TEXT("Pixel format the front panel screen is rendered into and read back in.  Each is converted directly, so this\n")
+	TEXT("can match whatever a UI or scene capture path drawing into the screen already uses.  Read when the screen is initialized.\n")
+	TEXT(" 0: B8G8R8A8 (default)\n")
+	TEXT(" 1: R8G8B8A8\n")
+	TEXT(" 2: A2B10G10R10\n")
+	TEXT(" 3: FloatRGBA"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPrewarmScreen(
+	TEXT("XboxFrontPanel.PrewarmScreen"),
+	0,
+	TEXT("When non-zero, front panel screen resources are created once the engine has initialized, as PrewarmScreen does,\n")
+	TEXT("so the first screen widget is shown without a hitch.  Read at startup."),
+	ECVF_ReadOnly);
+
+static TAutoConsoleVariable<float> CVarScreenKeepAliveTime(
+	TEXT("XboxFrontPanel.ScreenKeepAliveTime"),
+	5.0f,
+	TEXT("Seconds the front panel screen's window, render target and readback surfaces are kept after the screen widget is\n")
+	TEXT("cleared, so a widget set again within that time reuses them.  The screen itself is cleared straight away.\n")
+	TEXT("0 releases them immediately, a negative value keeps them until shutdown."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarButtonSampleRate(
+	TEXT("XboxFrontPanel.ButtonSampleRate"),
+	0.0f,
+	TEXT("When non-zero, front panel buttons are polled on a dedicated thread at this many samples per second (e.g. 500)\n")
+	TEXT("instead of once per Slate tick.  Presses shorter than a frame are kept and repeats are timed from the samples."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPerfHud(
+	TEXT("XboxFrontPanel.PerfHud"),
+	0,
+	TEXT("When non-zero, the front panel screen shows a performance HUD: frame rate, game, render and GPU times, memory,\n")
+	TEXT("hitches and a frame time graph.  It takes the screen over from any widget, canvas or animation until cleared.\n")
+	TEXT("See XboxFrontPanel.PerfHud.* for its settings."),
+	ECVF_Default);
+
+// Screen ids tag frames with the page they belong to.  Registered pages count up from 1.
+static const int32 ClearedScreenId = INDEX_NONE;
+static const int32 UnregisteredScreenId = 0;
+
+// Distance in bytes between rows of a mapped staging surface.  The XDK RHI reports the texture width and leaves the
+// pitch alignment to the caller, while other RHIs report the row pitch in pixels.
+static uint32 GetStagingSurfacePitch(int32 MappedWidth, uint32 BytesPerPixel)
+{
+#if PLATFORM_XBOXONE
+	return Align(MappedWidth * BytesPerPixel, D3D12XBOX_TEXTURE_DATA_PITCH_ALIGNMENT);
+#else
+	return MappedWidth * BytesPerPixel;
+#endif
+}
+
+static EPixelFormat GetSourcePixelFormat(EXboxFrontPanelSourceFormat Source)
+{
+	switch (Source)
+	{
+	case EXboxFrontPanelSourceFormat::RGBA8:
+		return PF_R8G8B8A8;
+	case EXboxFrontPanelSourceFormat::RGB10A2:
+		return PF_A2B10G10R10;
+	case EXboxFrontPanelSourceFormat::FloatRGBA16:
+		return PF_FloatRGBA;
+	default:
+		return PF_B8G8R8A8;
+	}
+}
+
+// Sees every key event the application receives, so it holds the module directly rather than looking it up by
+// name, and only offers the screen widget the keys its routing accepts.  Unregistered before the module shuts down.
+class FXboxFrontPanelInputProcessor : public IInputProcessor
+{
+public:
+	explicit FXboxFrontPanelInputProcessor(FXboxFrontPanelModule& InModule)
+		: Module(InModule)
+	{
+	}
+
+	virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override
+	{
+		Module.Tick(DeltaTime);
+	}
+
+	virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override
+	{
+		return Module.KeyFilter.Accepts(InKeyEvent.GetKey()) && Module.HandleKeyDownEvent(SlateApp, InKeyEvent);
+	}
+
+	virtual bool HandleKeyUpEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override
+	{
+		return Module.KeyFilter.Accepts(InKeyEvent.GetKey()) && Module.HandleKeyUpEvent(SlateApp, InKeyEvent);
+	}
+
+private:
+	FXboxFrontPanelModule& Module;
+};
+
+FXboxFrontPanelModule::FXboxFrontPanelModule()
+	: FrontScreenDataSize(0)
+	, RenderTarget(nullptr)
+	, ReadbackReadIndex(0)
+	, ReadbackWriteIndex(0)
+	, ReadbacksInFlight(0)
+	, bReadbackCopyPending(false)
+	, RenderTargetPaintTime(0.0)
+	, bPreviousScreenSourceValid(false)
+	, PreviousScreenKernel(EXboxFrontPanelLuminanceKernel::Scalar)
+	, PreviousScreenMode(EXboxFrontPanelLuminanceMode::FixedPoint)
+	, Width(0)
+	, Height(0)
+	, bScreenInfoValid(false)
+	, ScreenFormat(EXboxFrontPanelScreenFormat::R8)
+	, ScreenRowBytes(0)
+	, ScreenSourceFormat(EXboxFrontPanelSourceFormat::BGRA8)
+	, ScreenSourceBytesPerPixel(4)
+	, bCanvasPresentPending(false)
+	, bPerfHudShown(false)
+	, AnimationStartTime(0.0)
+	, bScreenDirty(true)
+	, PendingRedrawDeltaTime(0.0f)
+	, LastRedrawTime(0.0)
+	, ScreenReleaseTime(0.0)
+	, NextScreenId(UnregisteredScreenId + 1)
+	, PresentingScreenId(UnregisteredScreenId)
+	, ScreenSwitchCount(0)
+	, LightShadow(EXboxFrontPanelLights::None)
+	, CommittedLights(EXboxFrontPanelLights::None)
+{
+
+}
+
+void FXboxFrontPanelModule::StartupModule()
+{
+	FXboxFrontPanelModuleBase::StartupModule();
+
+	FString ShareName;
+	const bool bShare = FParse::Value(FCommandLine::Get(), TEXT("XboxFrontPanelShare="), ShareName) || FParse::Param(FCommandLine::Get(), TEXT("XboxFrontPanelShare"));
+	if (bShare && ShareName.IsEmpty())
+	{
+		ShareName = XboxFrontPanelSharedMemory::DefaultName;
+	}
+
+	FString ReplayFilename;
+	if (FParse::Value(FCommandLine::Get(), TEXT("XboxFrontPanelReplay="), ReplayFilename))
+	{
+		// Replays stand in for the panel, so they give the same results with or without one
+		Device = FXboxFrontPanelReplayDevice::Create(ReplayFilename);
+	}
+	else
+	{
+		Device = CreateXboxFrontPanelXdkDevice();
+		if (Device.IsValid())
+		{
+			UE_LOG(LogXboxFrontPanel, Log, TEXT("Xbox Front Panel is present!"));
+		}
+		else if (CVarSimulate.GetValueOnGameThread() != 0 || FParse::Param(FCommandLine::Get(), TEXT("XboxFrontPanelSim")) || bShare)
+		{
+			Device = FXboxFrontPanelSimulatedDevice::CreateFromConsoleVariables();
+			UE_LOG(LogXboxFrontPanel, Log, TEXT("Simulating the Xbox Front Panel."));
+		}
+	}
+
+	// Inside any capture, so injected buttons are captured and replayed like the panel's own
+	if (Device.IsValid() && bShare)
+	{
+		TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> SharedDevice = FXboxFrontPanelSharedMemoryDevice::Create(Device, ShareName);
+		if (SharedDevice.IsValid())
+		{
+			Device = SharedDevice;
+		}
+	}
+
+	FString CaptureFilename;
+	if (Device.IsValid() && FParse::Value(FCommandLine::Get(), TEXT("XboxFrontPanelCapture="), CaptureFilename))
+	{
+		TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> CaptureDevice = FXboxFrontPanelCaptureDevice::Create(Device, CaptureFilename);
+		if (CaptureDevice.IsValid())
+		{
+			Device = CaptureDevice;
+		}
+	}
+
+	if (Device.IsValid())
+	{
+		// Seed the shadow from the device once; from then on the module is the only writer
+		{
+			FRONT_PANEL_SCOPED_STAGE(GetLightStates);
+			if (Device->GetLightStates(LightShadow))
+			{
+				LightShadow &= EXboxFrontPanelLights::All;
+			}
+		}
+		CommittedLights = LightShadow;
+
+		// Without a panel there is no input to generate, and commandlets and other runs without Slate have nowhere to
+		// send it.  A simulated, shared or replayed panel can be created in any of them.
+		if (FSlateApplication::IsInitialized())
+		{
+			InputProcessor = MakeShared<FXboxFrontPanelInputProcessor>(*this);
+			FSlateApplication::Get().RegisterInputPreProcessor(InputProcessor);
+		}
+
+		if (CVarPrewarmScreen.GetValueOnGameThread() != 0)
+		{
+			// Render targets cannot be created this early in startup
+			PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddLambda([this]() { PrewarmScreen(); });
+		}
+	}
+}
+
+bool FXboxFrontPanelModule::IsFrontPanelAvailable()
+{
+	return Device.IsValid();
+}
+
+void FXboxFrontPanelModule::ShutdownModule()
+{
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+
+	// The preprocessor holds the module, so it must not outlive it
+	if (InputProcessor.IsValid())
+	{
+		if (FSlateApplication::IsInitialized())
+		{
+			FSlateApplication::Get().UnregisterInputPreProcessor(InputProcessor);
+		}
+		InputProcessor.Reset();
+	}
+
+	// Threads must not outlive the module's code
+	ButtonSampler.Reset();
+	AnimationPlayer.Reset();
+	PerfHud.Reset();
+
+	// The present worker is owned by the render side and converts into the module's screen data, so wait for the
+	// render thread to stop it before any of that is destroyed
+	DeinitScreenResources();
+	FlushRenderingCommands();
+}
+
+IXboxFrontPanelDevice* FXboxFrontPanelModule::GetDevice()
+{
+	return Device.Get();
+}
+
+void FXboxFrontPanelModule::SetInputConfig(const FXboxFrontPanelInputConfig& Config)
+{
+	InputEngine.SetConfig(Config);
+	KeyFilter.SetConfig(Config);
+}
+
+const FXboxFrontPanelInputConfig& FXboxFrontPanelModule::GetInputConfig()
+{
+	return InputEngine.GetConfig();
+}
+
+void FXboxFrontPanelModule::DrawScreen_RenderThread(FRHICommandListImmediate& RHICmdList, FTextureRenderTargetResource* GpuProducedScreenTexture, bool bScreenPainted, double PaintTime)
+{
+	SCOPED_NAMED_EVENT(FXboxFrontPanelModule_DrawScreen_RenderThread, FColor::Turquoise);
+	check(Device.IsValid());
+	check(GpuProducedScreenTexture != nullptr);
+
+	const int32 ReadbackDepth = FMath::Clamp(CVarReadbackDepth.GetValueOnRenderThread(), 1, MaxReadbackDepth);
+	if (ReadbackSlots.Num() != ReadbackDepth)
+	{
+		ResizeReadbackRing_RenderThread(ReadbackDepth);
+	}
+
+	if (bScreenPainted)
+	{
+		RenderTargetPaintTime = PaintTime;
+		bReadbackCopyPending = true;
+	}
+
+	PresentCompletedReadback_RenderThread();
+
+	bool bReadbackCopied = false;
+	if (bReadbackCopyPending)
+	{
+		if (ReadbacksInFlight < ReadbackSlots.Num())
+		{
+			FXboxFrontPanelReadbackSlot& Slot = ReadbackSlots[ReadbackWriteIndex];
+
+			auto TextureRHI = GpuProducedScreenTexture->GetTextureRenderTarget2DResource()->GetTextureRHI();
+			RHICmdList.CopyToResolveTarget(TextureRHI, Slot.Texture, false, FResolveParams());
+
+			Slot.Fence->Clear();
+			RHICmdList.WriteGPUFence(Slot.Fence);
+			Slot.PaintTime = RenderTargetPaintTime;
+			Slot.SwitchCount = ScreenSwitchCount;
+
+			ReadbackWriteIndex = (ReadbackWriteIndex + 1) % ReadbackSlots.Num();
+			++ReadbacksInFlight;
+			bReadbackCopyPending = false;
+			bReadbackCopied = true;
+		}
+		else
+		{
+			// Every slot is still waiting on the GPU.  Leave the copy pending rather than stall; the render target only
+			// holds the newest paint, so any paints before the next free slot are dropped.
+			INC_DWORD_STAT(STAT_XboxFrontPanel_FramesDropped);
+			CSV_CUSTOM_STAT(XboxFrontPanel, FramesDropped, 1, ECsvCustomStatOp::Accumulate);
+		}
+	}
+
+	if (bReadbackCopied && CVarLowLatency.GetValueOnRenderThread() != 0)
+	{
+		WaitForNewestReadback_RenderThread(RHICmdList);
+	}
+
+	SET_DWORD_STAT(STAT_XboxFrontPanel_ReadbacksInFlight, ReadbacksInFlight);
+	CSV_CUSTOM_STAT(XboxFrontPanel, ReadbacksInFlight, ReadbacksInFlight, ECsvCustomStatOp::Set);
+
+	bReadbackBusy = bReadbackCopyPending || ReadbacksInFlight > 0;
+}
+
+void FXboxFrontPanelModule::WaitForNewestReadback_RenderThread(FRHICommandListImmediate& RHICmdList)
+{
+	// Hand the copy to the GPU now, rather than whenever the render thread next flushes, so it can finish while we wait
+	RHICmdList.SubmitCommandsHint();
+	RHICmdList.ImmediateFlush(EImmediateFlushType::FlushRHIThread);
+
+	const FXboxFrontPanelReadbackSlot& NewestSlot = ReadbackSlots[(ReadbackWriteIndex + ReadbackSlots.Num() - 1) % ReadbackSlots.Num()];
+	const double Deadline = FPlatformTime::Seconds() + FMath::Max(CVarLowLatencyWaitTime.GetValueOnRenderThread(), 0.0f) * 1.0e-3;
+	while (!NewestSlot.Fence->Poll())
+	{
+		if (FPlatformTime::Seconds() >= Deadline)
+		{
+			// Picked up by the next frame's PresentCompletedReadback_RenderThread, as in the default mode
+			INC_DWORD_STAT(STAT_XboxFrontPanel_LowLatencyTimeouts);
+			return;
+		}
+		FPlatformProcess::SleepNoStats(0.0f);
+	}
+
+	INC_DWORD_STAT(STAT_XboxFrontPanel_LowLatencyReadbacks);
+	PresentCompletedReadback_RenderThread();
+}
+
+void FXboxFrontPanelModule::PresentCompletedReadback_RenderThread()
+{
+	// Fences signal in submission order.  Retire every completed slot but only map the newest of them.
+	int32 NewestCompletedIndex = INDEX_NONE;
+	while (ReadbacksInFlight > 0 && ReadbackSlots[ReadbackReadIndex].Fence->Poll())
+	{
+		if (NewestCompletedIndex != INDEX_NONE)
+		{
+			INC_DWORD_STAT(STAT_XboxFrontPanel_ReadbacksSuperseded);
+		}
+		NewestCompletedIndex = ReadbackReadIndex;
+		ReadbackReadIndex = (ReadbackReadIndex + 1) % ReadbackSlots.Num();
+		--ReadbacksInFlight;
+	}
+
+	if (NewestCompletedIndex == INDEX_NONE)
+	{
+		if (ReadbacksInFlight > 0)
+		{
+			// The newest copy is still on the GPU; a readback stall, since nothing new can reach the panel this frame
+			INC_DWORD_STAT(STAT_XboxFrontPanel_ReadbacksNotReady);
+			CSV_CUSTOM_STAT(XboxFrontPanel, ReadbackStalls, 1, ECsvCustomStatOp::Accumulate);
+		}
+		return;
+	}
+
+	FXboxFrontPanelReadbackSlot& Slot = ReadbackSlots[NewestCompletedIndex];
+	if (Slot.SwitchCount != ScreenSwitchCount)
+	{
+		// Copied before the screen was switched, as was everything that retired with it
+		INC_DWORD_STAT(STAT_XboxFrontPanel_ReadbacksSuperseded);
+		return;
+	}
+
+	uint8* ResultsBuffer = nullptr;
+	int32 MappedWidth = 0;
+	int32 MappedHeight = 0;
+
+	{
+		FRONT_PANEL_SCOPED_STAGE(MapStagingSurface);
+
+		// Note: not calling via RHICmdList because we don't want the ImmediateFlush
+		GDynamicRHI->RHIMapStagingSurface(Slot.Texture, *(void**)&ResultsBuffer, MappedWidth, MappedHeight);
+	}
+
+	if (PresentWorker.IsValid())
+	{
+		if (ResultsBuffer != nullptr)
+		{
+			uint8* Frame = PresentWorker->AcquireFrame();
+			if (Frame != nullptr)
+			{
+				SCOPED_NAMED_EVENT(FrontPanel_CopyForAsyncPresent, FColor::Turquoise);
+
+				check(MappedWidth >= static_cast<int32>(Width));
+				check(MappedHeight == Height);
+
+				const uint32 MappedPitch = GetStagingSurfacePitch(MappedWidth, ScreenSourceBytesPerPixel);
+				const uint32 RowBytes = Width * ScreenSourceBytesPerPixel;
+				for (uint32 Row = 0; Row < Height; ++Row)
+				{
+					FMemory::Memcpy(Frame + Row * RowBytes, ResultsBuffer + Row * MappedPitch, RowBytes);
+				}
+				PresentWorker->SubmitFrame(Frame, PresentingScreenId, Slot.PaintTime);
+			}
+			else
+			{
+				// The worker still holds every pooled buffer.  The render target has the newest paint, so copy it again
+				// next time rather than waiting here.
+				bReadbackCopyPending = true;
+				INC_DWORD_STAT(STAT_XboxFrontPanel_AsyncFramesDeferred);
+			}
+		}
+
+		// Note: not calling via RHICmdList because we don't want the ImmediateFlush
+		GDynamicRHI->RHIUnmapStagingSurface(Slot.Texture);
+		return;
+	}
+
+	bool bScreenChanged = false;
+	if (ResultsBuffer != nullptr)
+	{
+		SCOPED_NAMED_EVENT(FrontPanel_ComputeLuminance, FColor::Turquoise);
+
+		check(MappedWidth >= static_cast<int32>(Width));
+		check(MappedHeight == Height);
+
+		const uint32 MappedPitch = GetStagingSurfacePitch(MappedWidth, ScreenSourceBytesPerPixel);
+		bScreenChanged = ConvertChangedRows(ResultsBuffer, MappedPitch);
+	}
+
+	// Note: not calling via RHICmdList because we don't want the ImmediateFlush
+	GDynamicRHI->RHIUnmapStagingSurface(Slot.Texture);
+
+	PresentScreenData(bScreenChanged, PresentingScreenId, Slot.PaintTime);
+}
+
+void FXboxFrontPanelModule::PresentScreenData(bool bScreenChanged, int32 ScreenId, double PaintTime)
+{
+	FScopeLock PresentScopeLock(&PresentLock);
+	if (bPerfHudShown)
+	{
+		// The HUD has the screen.  Hiding it switches the screen data back, which presents the next frame in full.
+		return;
+	}
+
+	if (bScreenChanged)
+	{
+		SCOPED_NAMED_EVENT(FrontPanel_PresentBuffer, FColor::Turquoise);
+		{
+			FRONT_PANEL_SCOPED_STAGE(PresentBuffer);
+			Device->PresentBuffer(FrontScreenData.Get(), FrontScreenDataSize);
+		}
+		LatencyTracker.OnScreenPresented(PaintTime, FPlatformTime::Seconds());
+		INC_DWORD_STAT(STAT_XboxFrontPanel_FramesPresented);
+		CSV_CUSTOM_STAT(XboxFrontPanel, FramesPresented, 1, ECsvCustomStatOp::Accumulate);
+
+		if (ScreenId != UnregisteredScreenId)
+		{
+			// Kept so that showing the page again can put this frame straight back up
+			FScopeLock Lock(&ScreenFrameCacheLock);
+			if (TArray<uint8>* CachedFrame = ScreenFrameCache.Find(ScreenId))
+			{
+				CachedFrame->SetNumUninitialized(FrontScreenDataSize, false);
+				FMemory::Memcpy(CachedFrame->GetData(), FrontScreenData.Get(), FrontScreenDataSize);
+			}
+		}
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_XboxFrontPanel_FramesSkipped);
+		CSV_CUSTOM_STAT(XboxFrontPanel, FramesSkipped, 1, ECsvCustomStatOp::Accumulate);
+	}
+}
+
+void FXboxFrontPanelModule::ShowScreenData(int32 ScreenId)
+{
+	// The next frame has nothing to be compared against
+	bPreviousScreenSourceValid = false;
+
+	if (ScreenId == ClearedScreenId)
+	{
+		FMemory::Memzero(FrontScreenData.Get(), FrontScreenDataSize);
+	}
+	else
+	{
+		// Put the page's last frame up while its first live frame is painted and read back
+		FScopeLock Lock(&ScreenFrameCacheLock);
+		const TArray<uint8>* CachedFrame = ScreenFrameCache.Find(ScreenId);
+		if (CachedFrame == nullptr || CachedFrame->Num() != static_cast<int32>(FrontScreenDataSize))
+		{
+			return;
+		}
+		FMemory::Memcpy(FrontScreenData.Get(), CachedFrame->GetData(), FrontScreenDataSize);
+	}
+
+	{
+		FScopeLock PresentScopeLock(&PresentLock);
+		if (!bPerfHudShown)
+		{
+			{
+				FRONT_PANEL_SCOPED_STAGE(PresentBuffer);
+				Device->PresentBuffer(FrontScreenData.Get(), FrontScreenDataSize);
+			}
+			INC_DWORD_STAT(STAT_XboxFrontPanel_FramesPresented);
+			CSV_CUSTOM_STAT(XboxFrontPanel, FramesPresented, 1, ECsvCustomStatOp::Accumulate);
+		}
+	}
+
+	if (ScreenId == ClearedScreenId)
+	{
+		PendingScreenClears.Decrement();
+	}
+}
+
+void FXboxFrontPanelModule::ResizeReadbackRing_RenderThread(int32 Depth)
+{
+	// Any copies still in flight are abandoned along with the old slots
+	ReadbackSlots.Reset();
+	ReadbackSlots.SetNum(Depth);
+	for (FXboxFrontPanelReadbackSlot& Slot : ReadbackSlots)
+	{
+		FRHIResourceCreateInfo CreateInfo;
+		Slot.Texture = RHICreateTexture2D(Width, Height, GetSourcePixelFormat(ScreenSourceFormat), 1, 1, TexCreate_CPUReadback, CreateInfo);
+		Slot.Fence = RHICreateGPUFence(TEXT("XboxFrontPanelReadback"));
+		Slot.PaintTime = 0.0;
+		Slot.SwitchCount = ScreenSwitchCount;
+	}
+
+	ReadbackReadIndex = 0;
+	ReadbackWriteIndex = 0;
+	ReadbacksInFlight = 0;
+
+	// Make sure whatever is currently in the render target still reaches the panel
+	bReadbackCopyPending = true;
+}
+
+bool FXboxFrontPanelModule::ConvertChangedRows(const uint8* Src, uint32 SrcPitch)
+{
+	FRONT_PANEL_SCOPED_STAGE(ConvertLuminance);
+
+	const uint32 RowBytes = Width * ScreenSourceBytesPerPixel;
+
+	// Switching kernel or mode can change the output for identical input, so start over if either changed.
+	const EXboxFrontPanelLuminanceKernel Kernel = FXboxFrontPanelLuminance::GetActiveKernel();
+	const EXboxFrontPanelLuminanceMode Mode = FXboxFrontPanelLuminance::GetActiveMode();
+	const bool bCompareRows = bPreviousScreenSourceValid && Kernel == PreviousScreenKernel && Mode == PreviousScreenMode && CVarSkipUnchangedRows.GetValueOnAnyThread() != 0;
+
+	// Convert contiguous runs of changed rows with a single call so the kernels keep their loop overhead amortized.
+	uint32 ChangedRows = 0;
+	uint32 RunStart = 0;
+	for (uint32 Row = 0; Row <= Height; ++Row)
+	{
+		bool bRowChanged = false;
+		if (Row < Height)
+		{
+			const uint8* SrcRow = Src + Row * SrcPitch;
+			uint8* PreviousRow = PreviousScreenSource.Get() + Row * RowBytes;
+			bRowChanged = !bCompareRows || FMemory::Memcmp(SrcRow, PreviousRow, RowBytes) != 0;
+			if (bRowChanged)
+			{
+				FMemory::Memcpy(PreviousRow, SrcRow, RowBytes);
+				++ChangedRows;
+			}
+		}
+
+		if (!bRowChanged)
+		{
+			if (RunStart < Row)
+			{
+				FXboxFrontPanelLuminance::Convert(ScreenSourceFormat, ScreenFormat, Kernel, Mode, Src + RunStart * SrcPitch, SrcPitch, FrontScreenData.Get() + RunStart * ScreenRowBytes, ScreenRowBytes, Width, Row - RunStart, RunStart);
+			}
+			RunStart = Row + 1;
+		}
+	}
+
+	bPreviousScreenSourceValid = true;
+	PreviousScreenKernel = Kernel;
+	PreviousScreenMode = Mode;
+
+	INC_DWORD_STAT_BY(STAT_XboxFrontPanel_RowsConverted, ChangedRows);
+	INC_DWORD_STAT_BY(STAT_XboxFrontPanel_RowsSkipped, Height - ChangedRows);
+
+	return ChangedRows > 0;
+}
+
+bool FXboxFrontPanelModule::IsScreenRedrawNeeded() const
+{
+	if (bScreenDirty || CVarRedrawMode.GetValueOnGameThread() == 0)
+	{
+		return true;
+	}
+
+	// Animations only advance when painted, so keep painting for as long as any are running.
+	if (FrontScreenUserWidget.IsValid() && FrontScreenUserWidget->IsAnyAnimationPlaying())
+	{
+		return true;
+	}
+
+	const float MaxRedrawInterval = CVarMaxRedrawInterval.GetValueOnGameThread();
+	return MaxRedrawInterval > 0.0f && FPlatformTime::Seconds() - LastRedrawTime >= MaxRedrawInterval;
+}
+
+void FXboxFrontPanelModule::DrawScreen_GameThread(float DeltaTime)
+{
+	check(ActiveWindow.IsValid());
+	check(HitTestGrid.IsValid());
+	check(RenderTarget != nullptr);
+
+	// Time keeps passing for the widgets while they are not painted
+	PendingRedrawDeltaTime += DeltaTime;
+
+	const bool bScreenPainted = IsScreenRedrawNeeded();
+	if (bScreenPainted)
+	{
+		// CPU cost here will depend on the complexity of the UI hosted on the front panel.
+		// We do the best we can by allocating the window and hit test grid externally, plus avoiding the prepass and hit test clear when possible.
+		FRONT_PANEL_SCOPED_STAGE(DrawWindow);
+		WidgetRenderer.DrawWindow(RenderTarget, HitTestGrid.ToSharedRef(), ActiveWindow.ToSharedRef(), 1.0f, FVector2D(Width, Height), PendingRedrawDeltaTime);
+
+		// Should only ever need a pre-pass once per widget
+		WidgetRenderer.SetIsPrepassNeeded(false);
+
+		bScreenDirty = false;
+		PendingRedrawDeltaTime = 0.0f;
+		LastRedrawTime = FPlatformTime::Seconds();
+		LatencyTracker.OnScreenPainted(LastRedrawTime);
+	}
+	else if (!bReadbackBusy)
+	{
+		// Nothing new has been painted and every earlier paint has reached the panel, which keeps showing the last
+		// presented frame.
+		return;
+	}
+
+	FRONT_PANEL_SCOPED_STAGE(EnqueueReadback);
+	FTextureRenderTargetResource* GpuProducedScreenTexture = RenderTarget->GameThread_GetRenderTargetResource();
+	ENQUEUE_UNIQUE_RENDER_COMMAND_FOURPARAMETER(FXboxFrontPanelModule_Tick,
+		FXboxFrontPanelModule*, FrontPanelModule, this,
+		FTextureRenderTargetResource*, GpuProducedScreenTexture, GpuProducedScreenTexture,
+		bool, bScreenPainted, bScreenPainted,
+		double, PaintTime, LastRedrawTime,
+		{
+			SCOPED_DRAW_EVENT(RHICmdList, FrontPanelReadback);
+			FrontPanelModule->DrawScreen_RenderThread(RHICmdList, GpuProducedScreenTexture, bScreenPainted, PaintTime);
+		});
+}
+
+void FXboxFrontPanelModule::Tick(float DeltaTime)
+{
+	// In low latency mode input goes first, so this tick's paint already responds to it
+	const bool bInputBeforePaint = Device.IsValid() && CVarLowLatency.GetValueOnGameThread() != 0;
+	if (bInputBeforePaint)
+	{
+		GenerateButtonEvents();
+	}
+
+	if (Device.IsValid() && (CVarPerfHud.GetValueOnGameThread() != 0) != PerfHud.IsValid())
+	{
+		SetPerfHudShown(!PerfHud.IsValid());
+	}
+
+	if (PerfHud.IsValid())
+	{
+		TickPerfHud(DeltaTime);
+	}
+	else if (FrontScreenWidget.IsValid())
+	{
+		DrawScreen_GameThread(DeltaTime);
+	}
+	else
+	{
+		if (ScreenReleaseTime > 0.0 && FPlatformTime::Seconds() >= ScreenReleaseTime)
+		{
+			// No widget came back within XboxFrontPanel.ScreenKeepAliveTime
+			DeinitScreenResources();
+		}
+
+		if (AnimationPlayer.IsValid())
+		{
+			TickAnimation();
+		}
+
+		if (bCanvasPresentPending)
+		{
+			PresentPendingCanvas();
+		}
+	}
+
+	if (Device.IsValid())
+	{
+		if (!bInputBeforePaint)
+		{
+			GenerateButtonEvents();
+		}
+
+		// After input, so lights changed in response to this tick's presses go out this tick
+		CommitLightStates();
+	}
+}
+
+void FXboxFrontPanelModule::CommitLightStates()
+{
+	const EXboxFrontPanelLights Lights = ActiveLightSequences.Num() > 0 ? EvaluateLightSequences(FPlatformTime::Seconds()) : LightShadow;
+	if (Lights == CommittedLights)
+	{
+		return;
+	}
+
+	FRONT_PANEL_SCOPED_STAGE(SetLightStates);
+	if (Device->SetLightStates(Lights))
+	{
+		CommittedLights = Lights;
+	}
+}
+
+EXboxFrontPanelLights FXboxFrontPanelModule::EvaluateLightSequences(double CurrentTime)
+{
+	int32 Lights = static_cast<int32>(LightShadow);
+	int32 Resolved = 0;
+
+	for (int32 Index = 0; Index < ActiveLightSequences.Num(); )
+	{
+		const FXboxFrontPanelActiveLightSequence& Active = ActiveLightSequences[Index];
+		const double Elapsed = CurrentTime - Active.StartTime;
+		if (Active.Sequence == nullptr || (!Active.Sequence->bLooping && Elapsed >= Active.Sequence->GetPlayLength()))
+		{
+			ActiveLightSequences.RemoveAt(Index);
+			continue;
+		}
+
+		// Higher priority sequences already decided the lights in Resolved
+		int32 Covered;
+		const int32 SequenceLights = Active.Sequence->Evaluate(Elapsed, Covered);
+		const int32 Decides = Covered & ~Resolved;
+		Lights = (Lights & ~Decides) | (SequenceLights & Decides);
+		Resolved |= Covered;
+
+		++Index;
+	}
+
+	return static_cast<EXboxFrontPanelLights>(Lights) & EXboxFrontPanelLights::All;
+}
+
+void FXboxFrontPanelModule::GenerateButtonEvents()
+{
+	const float SampleRate = FMath::Max(CVarButtonSampleRate.GetValueOnGameThread(), 0.0f);
+	if (SampleRate != (ButtonSampler.IsValid() ? ButtonSampler->GetSampleRate() : 0.0f))
+	{
+		ButtonSampler.Reset();
+		if (SampleRate > 0.0f)
+		{
+			ButtonSampler = MakeUnique<FXboxFrontPanelButtonSampler>(Device, SampleRate);
+		}
+	}
+
+	if (ButtonSampler.IsValid())
+	{
+		// Replay every edge in the order it was sampled, then check repeats as of the newest sample
+		FXboxFrontPanelButtonEdge Edge;
+		while (ButtonSampler->DequeueEdge(Edge))
+		{
+			if (EnumHasAnyFlags(Edge.Buttons, ~InputEngine.GetButtonStates()))
+			{
+				LatencyTracker.OnButtonPressed(Edge.Time);
+			}
+			InputEngine.Update(Edge.Buttons, Edge.Time);
+		}
+
+		const double LatestSampleTime = ButtonSampler->GetLatestSampleTime();
+		if (LatestSampleTime > 0.0)
+		{
+			InputEngine.Update(InputEngine.GetButtonStates(), LatestSampleTime);
+		}
+		return;
+	}
+
+	EXboxFrontPanelButtons NewButtonStates;
+	{
+		FRONT_PANEL_SCOPED_STAGE(GetButtonStates);
+		if (!Device->GetButtonStates(NewButtonStates))
+		{
+			return;
+		}
+	}
+
+	const double SampleTime = FPlatformTime::Seconds();
+	if (EnumHasAnyFlags(NewButtonStates, ~InputEngine.GetButtonStates()))
+	{
+		LatencyTracker.OnButtonPressed(SampleTime);
+	}
+	InputEngine.Update(NewButtonStates, SampleTime);
+}
+
+void FXboxFrontPanelModule::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObject(RenderTarget);
+
+	for (FXboxFrontPanelActiveLightSequence& Active : ActiveLightSequences)
+	{
+		Collector.AddReferencedObject(Active.Sequence);
+	}
+}
+
+static const EXboxFrontPanelLights LightsByIndex[] =
+{
+	EXboxFrontPanelLights::Light1,
+	EXboxFrontPanelLights::Light2,
+	EXboxFrontPanelLights::Light3,
+	EXboxFrontPanelLights::Light4,
+	EXboxFrontPanelLights::Light5
+};
+
+void FXboxFrontPanelModule::SetButtonLightState(EXboxFrontPanelButtonLight Light, bool OnOff)
+{
+	if (Device.IsValid())
+	{
+		int32 ButtonIndex = static_cast<int32>(Light);
+		check(ButtonIndex < ARRAY_COUNT(LightsByIndex));
+
+		if (OnOff)
+		{
+			LightShadow |= LightsByIndex[ButtonIndex];
+		}
+		else
+		{
+			LightShadow &= ~LightsByIndex[ButtonIndex];
+		}
+	}
+}
+
+bool FXboxFrontPanelModule::GetButtonLightState(EXboxFrontPanelButtonLight Light)
+{
+	if (Device.IsValid())
+	{
+		int32 ButtonIndex = static_cast<int32>(Light);
+		check(ButtonIndex < ARRAY_COUNT(LightsByIndex));
+
+		return EnumHasAnyFlags(LightShadow, LightsByIndex[ButtonIndex]);
+	}
+
+	return false;
+}
+
+void FXboxFrontPanelModule::SetButtonLightMask(int32 Mask)
+{
+	if (Device.IsValid())
+	{
+		// Bit N of the mask is EXboxFrontPanelButtonLight value N, which is also LightsByIndex[N]
+		LightShadow = static_cast<EXboxFrontPanelLights>(Mask) & EXboxFrontPanelLights::All;
+	}
+}
+
+int32 FXboxFrontPanelModule::GetButtonLightMask()
+{
+	return Device.IsValid() ? static_cast<int32>(LightShadow) : 0;
+}
+
+void FXboxFrontPanelModule::PlayLightSequence(UXboxFrontPanelLightSequence* Sequence)
+{
+	if (Sequence == nullptr || !Device.IsValid())
+	{
+		return;
+	}
+
+	StopLightSequence(Sequence);
+
+	int32 InsertIndex = 0;
+	while (InsertIndex < ActiveLightSequences.Num() && ActiveLightSequences[InsertIndex].Priority > Sequence->Priority)
+	{
+		++InsertIndex;
+	}
+
+	FXboxFrontPanelActiveLightSequence Active;
+	Active.Sequence = Sequence;
+	Active.Priority = Sequence->Priority;
+	Active.StartTime = FPlatformTime::Seconds();
+	ActiveLightSequences.Insert(Active, InsertIndex);
+}
+
+void FXboxFrontPanelModule::StopLightSequence(UXboxFrontPanelLightSequence* Sequence)
+{
+	ActiveLightSequences.RemoveAll([Sequence](const FXboxFrontPanelActiveLightSequence& Active) { return Active.Sequence == Sequence; });
+}
+
+void FXboxFrontPanelModule::StopAllLightSequences()
+{
+	ActiveLightSequences.Reset();
+}
+
+void FXboxFrontPanelModule::SetScreenWidget(UUserWidget* Widget)
+{
+	if (Widget)
+	{
+		SetScreenWidget(Widget->TakeWidget());
+
+		// Tracked so that playing animations can keep the screen redrawing
+		FrontScreenUserWidget = Widget;
+	}
+	else
+	{
+		SetScreenWidget(TSharedPtr<SWidget>());
+	}
+}
+
+void FXboxFrontPanelModule::MarkScreenDirty()
+{
+	bScreenDirty = true;
+}
+
+bool FXboxFrontPanelModule::PrewarmScreen()
+{
+	return InitScreenResources();
+}
+
+FIntPoint FXboxFrontPanelModule::GetScreenSize()
+{
+	return QueryScreenInfo() ? FIntPoint(Width, Height) : FIntPoint::ZeroValue;
+}
+
+bool FXboxFrontPanelModule::PresentCanvas(const FXboxFrontPanelCanvas& Canvas)
+{
+	if (!QueryScreenInfo())
+	{
+		return false;
+	}
+
+	if (FrontScreenWidget.IsValid())
+	{
+		UE_LOG(LogXboxFrontPanel, Warning, TEXT("PresentCanvas ignored: a screen widget is set."));
+		return false;
+	}
 
-DEFINE_LOG_CATEGORY_STATIC(LogXboxFrontPanel, Log, All);
+	StopAnimation();
 
-class FXboxFrontPanelInputProcessor : public IInputProcessor
-{
-public:
-	virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override
+	if (Canvas.GetWidth() != static_cast<int32>(Width) || Canvas.GetHeight() != static_cast<int32>(Height))
 	{
-		static_cast<FXboxFrontPanelModule&>(IXboxFrontPanelModule::Get()).Tick(DeltaTime);
+		UE_LOG(LogXboxFrontPanel, Warning, TEXT("PresentCanvas ignored: canvas is %dx%d but the screen is %ux%u."), Canvas.GetWidth(), Canvas.GetHeight(), Width, Height);
+		return false;
 	}
 
-	virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override
+	const uint32 ScreenDataSize = ScreenRowBytes * Height;
+	TArray<uint8> PackedScreenData;
+	PackedScreenData.SetNumUninitialized(ScreenDataSize);
 	{
-		return static_cast<FXboxFrontPanelModule&>(IXboxFrontPanelModule::Get()).HandleKeyDownEvent(SlateApp, InKeyEvent);
+		FRONT_PANEL_SCOPED_STAGE(PackCanvas);
+		FXboxFrontPanelLuminance::PackR8(ScreenFormat, Canvas.GetData(), Canvas.GetPitch(), PackedScreenData.GetData(), ScreenRowBytes, Width, Height);
 	}
 
-	virtual bool HandleKeyUpEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override
+	if (!bCanvasPresentPending && PackedScreenData == CanvasScreenData)
 	{
-		return static_cast<FXboxFrontPanelModule&>(IXboxFrontPanelModule::Get()).HandleKeyUpEvent(SlateApp, InKeyEvent);
+		INC_DWORD_STAT(STAT_XboxFrontPanel_FramesSkipped);
+		CSV_CUSTOM_STAT(XboxFrontPanel, FramesSkipped, 1, ECsvCustomStatOp::Accumulate);
+		return true;
 	}
-};
 
-const double FXboxFrontPanelModule::InitialButtonRepeatDelay = 0.2;
-const double FXboxFrontPanelModule::ButtonRepeatDelay = 0.1;
+	CanvasScreenData = MoveTemp(PackedScreenData);
+	bCanvasPresentPending = true;
+	PresentPendingCanvas();
+	return true;
+}
 
-FXboxFrontPanelModule::FXboxFrontPanelModule()
-	: FrontScreenDataSize(0)
-	, RenderTarget(nullptr)
-	, CPUTextureIndex(0)
-	, Width(0)
-	, Height(0)
+void FXboxFrontPanelModule::PresentPendingCanvas()
 {
+	if (PendingScreenClears.GetValue() > 0)
+	{
+		// The render thread has yet to clear the screen after the last widget.  Tick tries again.
+		return;
+	}
+
+	if (PerfHud.IsValid())
+	{
+		// Kept pending until the HUD is hidden
+		return;
+	}
+
+	{
+		FScopeLock PresentScopeLock(&PresentLock);
+		FRONT_PANEL_SCOPED_STAGE(PresentBuffer);
+		Device->PresentBuffer(CanvasScreenData.GetData(), CanvasScreenData.Num());
+	}
+	bCanvasPresentPending = false;
 
+	INC_DWORD_STAT(STAT_XboxFrontPanel_FramesPresented);
+	CSV_CUSTOM_STAT(XboxFrontPanel, FramesPresented, 1, ECsvCustomStatOp::Accumulate);
 }
 
-void FXboxFrontPanelModule::StartupModule()
+void FXboxFrontPanelModule::SetPerfHudShown(bool bShown)
 {
-	FXboxFrontPanelModuleBase::StartupModule();
-
-	// Note: When IsXboxFrontPanelAvailable returns TRUE it also transitions the front screen to title
-	// ownership.  The screen will be blank until the title provides a widget to draw (or the user holds
-	// the directional button to flip back to the system display)
-	if (IsXboxFrontPanelAvailable() == TRUE)
+	if (bShown)
 	{
-		IXboxFrontPanelControl* FrontPanelRaw = nullptr;
-		if (SUCCEEDED(GetDefaultXboxFrontPanel(&FrontPanelRaw)))
+		if (!QueryScreenInfo())
 		{
-			UE_LOG(LogXboxFrontPanel, Log, TEXT("Xbox Front Panel is present!"));
-			check(FrontPanelRaw);
-			FrontPanel.Attach(FrontPanelRaw);
-
-			LastButtonStates = XBOX_FRONT_PANEL_BUTTONS_NONE;
-			FMemory::Memzero(NextButtonRepeatTime);
+			return;
 		}
+
+		PerfHud = MakeUnique<FXboxFrontPanelPerfHud>(Width, Height);
+		PerfHudScreenData.SetNumUninitialized(ScreenRowBytes * Height);
+
+		// Waits out any widget frame being presented, and holds back the rest
+		FScopeLock PresentScopeLock(&PresentLock);
+		bPerfHudShown = true;
+		return;
 	}
 
-	FSlateApplication::Get().RegisterInputPreProcessor(MakeShared<FXboxFrontPanelInputProcessor>());
-}
+	PerfHud.Reset();
+	PerfHudScreenData.Empty();
+	{
+		FScopeLock PresentScopeLock(&PresentLock);
+		bPerfHudShown = false;
+	}
 
-bool FXboxFrontPanelModule::IsFrontPanelAvailable()
-{
-	return FrontPanel != nullptr;
+	// Put back whatever the HUD was covering
+	if (FrontScreenWidget.IsValid())
+	{
+		const FXboxFrontPanelRegisteredScreen* Screen = RegisteredScreens.Find(ActiveScreen);
+		SwitchScreenData(Screen ? Screen->Id : UnregisteredScreenId);
+		MarkScreenDirty();
+	}
+	else if (CanvasScreenData.Num() > 0)
+	{
+		bCanvasPresentPending = true;
+	}
+	else
+	{
+		TArray<uint8> Blank;
+		Blank.SetNumZeroed(ScreenRowBytes * Height);
+		FScopeLock PresentScopeLock(&PresentLock);
+		FRONT_PANEL_SCOPED_STAGE(PresentBuffer);
+		Device->PresentBuffer(Blank.GetData(), Blank.Num());
+	}
 }
 
-void FXboxFrontPanelModule::DrawScreen_RenderThread(FRHICommandListImmediate& RHICmdList, FTextureRenderTargetResource* GpuProducedScreenTexture)
+void FXboxFrontPanelModule::TickPerfHud(float DeltaTime)
 {
-	SCOPED_NAMED_EVENT(FXboxFrontPanelModule_DrawScreen_RenderThread, FColor::Turquoise);
-	check(FrontPanel != nullptr);
-	check(GpuProducedScreenTexture != nullptr);
-	if (CPUTexture[CPUTextureIndex])
 	{
-		BYTE* ResultsBuffer = nullptr;
-		int32 MappedWidth = 0;
-		int32 MappedHeight = 0;
-
-		// Note: not calling via RHICmdList because we don't want the ImmediateFlush
-		GDynamicRHI->RHIMapStagingSurface(CPUTexture[CPUTextureIndex], *(void**)&ResultsBuffer, MappedWidth, MappedHeight);
-		if (ResultsBuffer != nullptr)
+		FRONT_PANEL_SCOPED_STAGE(PerfHud);
+		PerfHud->AddFrame(DeltaTime);
+		if (!PerfHud->Update(FPlatformTime::Seconds()))
 		{
-			SCOPED_NAMED_EVENT(FrontPanel_ComputeLuminance, FColor::Turquoise);
-
-			check(MappedWidth == Width);
-			check(MappedHeight == Height);
+			return;
+		}
+	}
 
-			int MappedWidthBytes = MappedWidth * 4;
-			int32 MappedPitch = Align(MappedWidthBytes, D3D12XBOX_TEXTURE_DATA_PITCH_ALIGNMENT);
-			check(MappedWidthBytes % 64 == 0);
+	const FXboxFrontPanelCanvas& Canvas = PerfHud->GetCanvas();
+	{
+		FRONT_PANEL_SCOPED_STAGE(PackCanvas);
+		FXboxFrontPanelLuminance::PackR8(ScreenFormat, Canvas.GetData(), Canvas.GetPitch(), PerfHudScreenData.GetData(), ScreenRowBytes, Width, Height);
+	}
 
-			const VectorRegister LuminanceFactor = VectorSetFloat3(0.11f, 0.59f, 0.3f);
-			const __m128i ZeroVector = _mm_setzero_si128();
+	{
+		FScopeLock PresentScopeLock(&PresentLock);
+		FRONT_PANEL_SCOPED_STAGE(PresentBuffer);
+		Device->PresentBuffer(PerfHudScreenData.GetData(), PerfHudScreenData.Num());
+	}
+	INC_DWORD_STAT(STAT_XboxFrontPanel_FramesPresented);
+	CSV_CUSTOM_STAT(XboxFrontPanel, FramesPresented, 1, ECsvCustomStatOp::Accumulate);
+}
 
-			BYTE* Dest = FrontScreenData.Get();
-			const BYTE* SrcSurfaceBegin = ResultsBuffer;
-			const BYTE* SrcSurfaceEnd = SrcSurfaceBegin + MappedHeight * MappedPitch;
+bool FXboxFrontPanelModule::PlayAnimation(const FString& Filename, bool bLoop)
+{
+	if (!QueryScreenInfo())
+	{
+		return false;
+	}
 
-			for (const BYTE* Line = SrcSurfaceBegin; Line < SrcSurfaceEnd; Line += MappedPitch)
-			{
-				const BYTE* LineEnd = Line + MappedPitch;
-				for (const BYTE* SrcPixelBlock = Line; SrcPixelBlock < LineEnd; SrcPixelBlock += 64)
-				{
-					// Operate on 16 pixels at a time in order to produce a single __m128's worth
-					// of 8bpp output.  Divided into two blocks of 8 for performance.
-
-					// First set of 8 pixels
-					// Profiling indicates that this version is faster than a simpler version using 16 x VectorLoadByte4
-					VectorRegisterInt Src0123 = _mm_load_si128(reinterpret_cast<const VectorRegisterInt*>(SrcPixelBlock + 0));
-					VectorRegisterInt Src4567 = _mm_load_si128(reinterpret_cast<const VectorRegisterInt*>(SrcPixelBlock + 16));
-
-					// Unpack so each channel is 32bit and convert to float.
-					VectorRegister Src0 = _mm_cvtepi32_ps(_mm_unpacklo_epi8(_mm_unpacklo_epi8(Src0123, ZeroVector), ZeroVector));
-					VectorRegister Src1 = _mm_cvtepi32_ps(_mm_unpackhi_epi8(_mm_unpacklo_epi8(Src0123, ZeroVector), ZeroVector));
-					VectorRegister Src2 = _mm_cvtepi32_ps(_mm_unpacklo_epi8(_mm_unpackhi_epi8(Src0123, ZeroVector), ZeroVector));
-					VectorRegister Src3 = _mm_cvtepi32_ps(_mm_unpackhi_epi8(_mm_unpackhi_epi8(Src0123, ZeroVector), ZeroVector));
-					VectorRegister Src4 = _mm_cvtepi32_ps(_mm_unpacklo_epi8(_mm_unpacklo_epi8(Src4567, ZeroVector), ZeroVector));
-					VectorRegister Src5 = _mm_cvtepi32_ps(_mm_unpackhi_epi8(_mm_unpacklo_epi8(Src4567, ZeroVector), ZeroVector));
-					VectorRegister Src6 = _mm_cvtepi32_ps(_mm_unpacklo_epi8(_mm_unpackhi_epi8(Src4567, ZeroVector), ZeroVector));
-					VectorRegister Src7 = _mm_cvtepi32_ps(_mm_unpackhi_epi8(_mm_unpackhi_epi8(Src4567, ZeroVector), ZeroVector));
-
-					// Luminance computation
-					VectorRegister Lum0 = VectorDot3(Src0, LuminanceFactor);
-					VectorRegister Lum1 = VectorDot3(Src1, LuminanceFactor);
-					VectorRegister Lum2 = VectorDot3(Src2, LuminanceFactor);
-					VectorRegister Lum3 = VectorDot3(Src3, LuminanceFactor);
-					VectorRegister Lum4 = VectorDot3(Src4, LuminanceFactor);
-					VectorRegister Lum5 = VectorDot3(Src5, LuminanceFactor);
-					VectorRegister Lum6 = VectorDot3(Src6, LuminanceFactor);
-					VectorRegister Lum7 = VectorDot3(Src7, LuminanceFactor);
-
-					// Pack back down again to 16bit integer luminance per pixel
-					VectorRegister Lum0011 = VectorShuffle(Lum0, Lum1, 0, 0, 0, 0);
-					VectorRegister Lum2233 = VectorShuffle(Lum2, Lum3, 0, 0, 0, 0);
-					VectorRegister Lum0123 = VectorShuffle(Lum0011, Lum2233, 0, 2, 0, 2);
-					VectorRegisterInt Lum0123Int = _mm_cvtps_epi32(Lum0123);
-
-					VectorRegister Lum4455 = VectorShuffle(Lum4, Lum5, 0, 0, 0, 0);
-					VectorRegister Lum6677 = VectorShuffle(Lum6, Lum7, 0, 0, 0, 0);
-					VectorRegister Lum4567 = VectorShuffle(Lum4455, Lum6677, 0, 2, 0, 2);
-					VectorRegisterInt Lum4567Int = _mm_cvtps_epi32(Lum4567);
-
-					VectorRegisterInt Lum01234567 = _mm_packus_epi32(Lum0123Int, Lum4567Int);
-
-					// Now repeat the above with the next set of 8 pixels
-					VectorRegisterInt Src89ab = _mm_load_si128(reinterpret_cast<const VectorRegisterInt*>(SrcPixelBlock + 32));
-					VectorRegisterInt Srccdef = _mm_load_si128(reinterpret_cast<const VectorRegisterInt*>(SrcPixelBlock + 48));
-
-					VectorRegister Src8 = _mm_cvtepi32_ps(_mm_unpacklo_epi8(_mm_unpacklo_epi8(Src89ab, ZeroVector), ZeroVector));
-					VectorRegister Src9 = _mm_cvtepi32_ps(_mm_unpackhi_epi8(_mm_unpacklo_epi8(Src89ab, ZeroVector), ZeroVector));
-					VectorRegister Srca = _mm_cvtepi32_ps(_mm_unpacklo_epi8(_mm_unpackhi_epi8(Src89ab, ZeroVector), ZeroVector));
-					VectorRegister Srcb = _mm_cvtepi32_ps(_mm_unpackhi_epi8(_mm_unpackhi_epi8(Src89ab, ZeroVector), ZeroVector));
-					VectorRegister Srcc = _mm_cvtepi32_ps(_mm_unpacklo_epi8(_mm_unpacklo_epi8(Srccdef, ZeroVector), ZeroVector));
-					VectorRegister Srcd = _mm_cvtepi32_ps(_mm_unpackhi_epi8(_mm_unpacklo_epi8(Srccdef, ZeroVector), ZeroVector));
-					VectorRegister Srce = _mm_cvtepi32_ps(_mm_unpacklo_epi8(_mm_unpackhi_epi8(Srccdef, ZeroVector), ZeroVector));
-					VectorRegister Srcf = _mm_cvtepi32_ps(_mm_unpackhi_epi8(_mm_unpackhi_epi8(Srccdef, ZeroVector), ZeroVector));
-
-					VectorRegister Lum8 = VectorDot3(Src8, LuminanceFactor);
-					VectorRegister Lum9 = VectorDot3(Src9, LuminanceFactor);
-					VectorRegister Luma = VectorDot3(Srca, LuminanceFactor);
-					VectorRegister Lumb = VectorDot3(Srcb, LuminanceFactor);
-					VectorRegister Lumc = VectorDot3(Srcc, LuminanceFactor);
-					VectorRegister Lumd = VectorDot3(Srcd, LuminanceFactor);
-					VectorRegister Lume = VectorDot3(Srce, LuminanceFactor);
-					VectorRegister Lumf = VectorDot3(Srcf, LuminanceFactor);
-
-					VectorRegister Lum8899 = VectorShuffle(Lum8, Lum9, 0, 0, 0, 0);
-					VectorRegister Lumaabb = VectorShuffle(Luma, Lumb, 0, 0, 0, 0);
-					VectorRegister Lum89ab = VectorShuffle(Lum8899, Lumaabb, 0, 2, 0, 2);
-					VectorRegisterInt Lum89abInt = _mm_cvttps_epi32(Lum89ab);
-
-					VectorRegister Lumccdd = VectorShuffle(Lumc, Lumd, 0, 0, 0, 0);
-					VectorRegister Lumeeff = VectorShuffle(Lume, Lumf, 0, 0, 0, 0);
-					VectorRegister Lumcdef = VectorShuffle(Lumccdd, Lumeeff, 0, 2, 0, 2);
-					VectorRegisterInt LumcdefInt = _mm_cvttps_epi32(Lumcdef);
-
-					VectorRegisterInt Lum89abcdef = _mm_packus_epi32(Lum89abInt, LumcdefInt);
-
-					// Finally, pack the 2 sets of 16bit luminance values to 8bpp and store.
-					_mm_store_si128(reinterpret_cast<VectorRegisterInt*>(Dest), _mm_packus_epi16(Lum01234567, Lum89abcdef));
-
-					Dest += 16;
-				}
-			}
+	if (FrontScreenWidget.IsValid())
+	{
+		UE_LOG(LogXboxFrontPanel, Warning, TEXT("PlayAnimation ignored: a screen widget is set."));
+		return false;
+	}
 
-			VectorResetFloatRegisters();
-		}
+	TUniquePtr<FXboxFrontPanelAnimationPlayer> NewPlayer = FXboxFrontPanelAnimationPlayer::Open(Filename, bLoop);
+	if (!NewPlayer.IsValid())
+	{
+		return false;
+	}
 
-		// Note: not calling via RHICmdList because we don't want the ImmediateFlush
-		GDynamicRHI->RHIUnmapStagingSurface(CPUTexture[CPUTextureIndex]);
+	if (NewPlayer->GetWidth() != static_cast<int32>(Width) || NewPlayer->GetHeight() != static_cast<int32>(Height))
+	{
+		UE_LOG(LogXboxFrontPanel, Warning, TEXT("PlayAnimation ignored: %s is %dx%d but the screen is %ux%u."), *Filename, NewPlayer->GetWidth(), NewPlayer->GetHeight(), Width, Height);
+		return false;
+	}
 
-		{
-			SCOPED_NAMED_EVENT(FrontPanel_PresentBuffer, FColor::Turquoise);
-			FrontPanel->PresentBuffer(FrontScreenDataSize, FrontScreenData.Get());
-		}
+	// R8 frames are already in the panel's format, so they decode in place.  Packed formats keep one 8bpp frame to
+	// decode deltas against.
+	CanvasScreenData.SetNumUninitialized(ScreenRowBytes * Height);
+	if (ScreenFormat == EXboxFrontPanelScreenFormat::R8)
+	{
+		AnimationFrame.Empty();
 	}
 	else
 	{
-		FRHIResourceCreateInfo CreateInfo;
-		CPUTexture[CPUTextureIndex] = RHICreateTexture2D(Width, Height, PF_B8G8R8A8, 1, 1, TexCreate_CPUReadback, CreateInfo);
+		AnimationFrame.SetNumUninitialized(Width * Height);
 	}
-	auto TextureRHI = GpuProducedScreenTexture->GetTextureRenderTarget2DResource()->GetTextureRHI();
-	RHICmdList.CopyToResolveTarget(TextureRHI, CPUTexture[CPUTextureIndex], false, FResolveParams());
 
-	CPUTextureIndex = CPUTextureIndex == 0 ? 1 : 0;
+	AnimationPlayer = MoveTemp(NewPlayer);
+	AnimationStartTime = FPlatformTime::Seconds();
+
+	// Show the first frame now rather than on the next tick
+	TickAnimation();
+	return true;
 }
 
-void FXboxFrontPanelModule::DrawScreen_GameThread(float DeltaTime)
+void FXboxFrontPanelModule::StopAnimation()
 {
-	check(Window.IsValid());
-	check(HitTestGrid.IsValid());
-	check(RenderTarget != nullptr);
-
-	// CPU cost here will depend on the complexity of the UI hosted on the front panel.
-	// We do the best we can by allocating the window and hit test grid externally, plus avoiding the prepass and hit test clear when possible.
-	WidgetRenderer.DrawWindow(RenderTarget, HitTestGrid.ToSharedRef(), Window.ToSharedRef(), 1.0f, FVector2D(Width, Height), DeltaTime);
-
-	// Should only ever need a pre-pass once per widget
-	WidgetRenderer.SetIsPrepassNeeded(false);
+	AnimationPlayer.Reset();
+	AnimationFrame.Empty();
+}
 
-	FTextureRenderTargetResource* GpuProducedScreenTexture = RenderTarget->GameThread_GetRenderTargetResource();
-	ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(FXboxFrontPanelModule_Tick,
-		FXboxFrontPanelModule*, FrontPanelModule, this,
-		FTextureRenderTargetResource*, GpuProducedScreenTexture, GpuProducedScreenTexture,
-		{
-			SCOPED_DRAW_EVENT(RHICmdList, FrontPanelReadback);
-			FrontPanelModule->DrawScreen_RenderThread(RHICmdList, GpuProducedScreenTexture);
-		});
+bool FXboxFrontPanelModule::IsAnimationPlaying()
+{
+	return AnimationPlayer.IsValid();
 }
 
-void FXboxFrontPanelModule::Tick(float DeltaTime)
+void FXboxFrontPanelModule::TickAnimation()
 {
-	if (Window.IsValid())
+	const bool bDecodeInPlace = AnimationFrame.Num() == 0;
+	uint8* Frame = bDecodeInPlace ? CanvasScreenData.GetData() : AnimationFrame.GetData();
+
+	if (AnimationPlayer->Update(FPlatformTime::Seconds() - AnimationStartTime, Frame, Width))
 	{
-		DrawScreen_GameThread(DeltaTime);
+		if (!bDecodeInPlace)
+		{
+			FRONT_PANEL_SCOPED_STAGE(PackCanvas);
+			FXboxFrontPanelLuminance::PackR8(ScreenFormat, Frame, Width, CanvasScreenData.GetData(), ScreenRowBytes, Width, Height);
+		}
+
+		bCanvasPresentPending = true;
+		PresentPendingCanvas();
 	}
 
-	if (FrontPanel != nullptr)
+	if (AnimationPlayer->IsFinished())
 	{
-		GenerateButtonEvents();
+		StopAnimation();
 	}
 }
 
-void FXboxFrontPanelModule::GenerateSingleButtonEvent(int32 NewState, int32 LastState, FGamepadKeyNames::Type KeyName, double CurrentTime, double& RepeatAt)
+void FXboxFrontPanelModule::SetScreenWidget(TSharedPtr<SWidget> Widget)
 {
-	if (NewState != 0)
+	FrontScreenUserWidget.Reset();
+
+	if (Widget.IsValid())
 	{
-		if (LastState == 0)
-		{
-			FSlateApplication::Get().OnControllerButtonPressed(KeyName, 0, false);
-			RepeatAt = CurrentTime + InitialButtonRepeatDelay;
-		}
-		else if (CurrentTime >= RepeatAt)
+		if (!InitScreenResources())
 		{
-			FSlateApplication::Get().OnControllerButtonPressed(KeyName, 0, true);
-			RepeatAt = CurrentTime + ButtonRepeatDelay;
+			UE_LOG(LogXboxFrontPanel, Warning, TEXT("SetScreenWidget ignored: Xbox Front Panel screen is not supported."));
+			return;
 		}
+
+		check(Window.IsValid());
+		Window->SetContent(Widget.ToSharedRef());
+
+		// New widget needs a new prepass
+		ActivateScreen(NAME_None, Widget.ToSharedRef(), Window.ToSharedRef(), UnregisteredScreenId, true);
 	}
-	else if (LastState != 0)
+	else if (FrontScreenWidget.IsValid())
 	{
-		FSlateApplication::Get().OnControllerButtonReleased(KeyName, 0, false);
+		DeactivateScreen();
 	}
 }
 
-void FXboxFrontPanelModule::GenerateButtonEvents()
+bool FXboxFrontPanelModule::RegisterScreen(FName Name, TSharedPtr<SWidget> Widget)
 {
-	XBOX_FRONT_PANEL_BUTTONS NewButtonStates;
-	HRESULT ButtonStateResult = FrontPanel->GetButtonStates(&NewButtonStates);
-	if (FAILED(ButtonStateResult))
+	if (Name.IsNone() || !Widget.IsValid())
 	{
-		UE_LOG(LogXboxFrontPanel, Warning, TEXT("Failed to read Xbox Front Panel button states: %08X"), ButtonStateResult);
-		return;
+		UE_LOG(LogXboxFrontPanel, Warning, TEXT("RegisterScreen ignored: a screen needs a name and a widget."));
+		return false;
 	}
 
-	const double CurrentTime = FPlatformTime::Seconds();
-	GenerateSingleButtonEvent(NewButtonStates & XBOX_FRONT_PANEL_BUTTONS_BUTTON1, LastButtonStates & XBOX_FRONT_PANEL_BUTTONS_BUTTON1, XboxFrontPanelKeyNames::Button1, CurrentTime, NextButtonRepeatTime[0]);
-	GenerateSingleButtonEvent(NewButtonStates & XBOX_FRONT_PANEL_BUTTONS_BUTTON2, LastButtonStates & XBOX_FRONT_PANEL_BUTTONS_BUTTON2, XboxFrontPanelKeyNames::Button2, CurrentTime, NextButtonRepeatTime[1]);
-	GenerateSingleButtonEvent(NewButtonStates & XBOX_FRONT_PANEL_BUTTONS_BUTTON3, LastButtonStates & XBOX_FRONT_PANEL_BUTTONS_BUTTON3, XboxFrontPanelKeyNames::Button3, CurrentTime, NextButtonRepeatTime[2]);
-	GenerateSingleButtonEvent(NewButtonStates & XBOX_FRONT_PANEL_BUTTONS_BUTTON4, LastButtonStates & XBOX_FRONT_PANEL_BUTTONS_BUTTON4, XboxFrontPanelKeyNames::Button4, CurrentTime, NextButtonRepeatTime[3]);
-	GenerateSingleButtonEvent(NewButtonStates & XBOX_FRONT_PANEL_BUTTONS_BUTTON5, LastButtonStates & XBOX_FRONT_PANEL_BUTTONS_BUTTON5, XboxFrontPanelKeyNames::Button5, CurrentTime, NextButtonRepeatTime[4]);
+	if (!QueryScreenInfo())
+	{
+		UE_LOG(LogXboxFrontPanel, Warning, TEXT("RegisterScreen ignored: Xbox Front Panel screen is not supported."));
+		return false;
+	}
 
-	GenerateSingleButtonEvent(NewButtonStates & XBOX_FRONT_PANEL_BUTTONS_LEFT, LastButtonStates & XBOX_FRONT_PANEL_BUTTONS_LEFT, XboxFrontPanelKeyNames::DPadLeft, CurrentTime, NextButtonRepeatTime[5]);
-	GenerateSingleButtonEvent(NewButtonStates & XBOX_FRONT_PANEL_BUTTONS_RIGHT, LastButtonStates & XBOX_FRONT_PANEL_BUTTONS_RIGHT, XboxFrontPanelKeyNames::DPadRight, CurrentTime, NextButtonRepeatTime[6]);
-	GenerateSingleButtonEvent(NewButtonStates & XBOX_FRONT_PANEL_BUTTONS_UP, LastButtonStates & XBOX_FRONT_PANEL_BUTTONS_UP, XboxFrontPanelKeyNames::DPadUp, CurrentTime, NextButtonRepeatTime[7]);
-	GenerateSingleButtonEvent(NewButtonStates & XBOX_FRONT_PANEL_BUTTONS_DOWN, LastButtonStates & XBOX_FRONT_PANEL_BUTTONS_DOWN, XboxFrontPanelKeyNames::DPadDown, CurrentTime, NextButtonRepeatTime[8]);
+	// A new widget under the same name starts over, cached frame and all
+	const bool bWasActive = ActiveScreen == Name;
+	UnregisterScreen(Name);
 
-	GenerateSingleButtonEvent(NewButtonStates & XBOX_FRONT_PANEL_BUTTONS_SELECT, LastButtonStates & XBOX_FRONT_PANEL_BUTTONS_SELECT, XboxFrontPanelKeyNames::DPadPress, CurrentTime, NextButtonRepeatTime[9]);
+	FXboxFrontPanelRegisteredScreen& Screen = RegisteredScreens.Add(Name);
+	Screen.Id = NextScreenId++;
+	Screen.Widget = Widget;
+	Screen.Window = SNew(SVirtualWindow).Size(FVector2D(Width, Height));
+	Screen.Window->Resize(FVector2D(Width, Height));
+	Screen.Window->SetContent(Widget.ToSharedRef());
+	Screen.bNeedsPrepass = true;
 
-	LastButtonStates = NewButtonStates;
-}
+	{
+		FScopeLock Lock(&ScreenFrameCacheLock);
+		ScreenFrameCache.Add(Screen.Id);
+	}
 
-void FXboxFrontPanelModule::AddReferencedObjects(FReferenceCollector& Collector)
-{
-	Collector.AddReferencedObject(RenderTarget);
-}
+	if (bWasActive)
+	{
+		ShowScreen(Name);
+	}
 
-static const XBOX_FRONT_PANEL_LIGHTS LightsByIndex[] =
-{
-	XBOX_FRONT_PANEL_LIGHTS_LIGHT1,
-	XBOX_FRONT_PANEL_LIGHTS_LIGHT2,
-	XBOX_FRONT_PANEL_LIGHTS_LIGHT3,
-	XBOX_FRONT_PANEL_LIGHTS_LIGHT4,
-	XBOX_FRONT_PANEL_LIGHTS_LIGHT5
-};
+	return true;
+}
 
-void FXboxFrontPanelModule::SetButtonLightState(EXboxFrontPanelButtonLight Light, bool OnOff)
+bool FXboxFrontPanelModule::RegisterScreen(FName Name, UUserWidget* Widget)
 {
-	if (FrontPanel != nullptr)
+	if (Widget == nullptr || !RegisterScreen(Name, Widget->TakeWidget()))
 	{
-		int32 ButtonIndex = static_cast<int32>(Light);
-		check(ButtonIndex < _countof(LightsByIndex));
+		return false;
+	}
 
-		XBOX_FRONT_PANEL_LIGHTS CurrentLightState = XBOX_FRONT_PANEL_LIGHTS_NONE;
-		HRESULT GetLightStateResult = FrontPanel->GetLightStates(&CurrentLightState);
-		if (SUCCEEDED(GetLightStateResult))
-		{
-			if (OnOff)
-			{
-				CurrentLightState = static_cast<XBOX_FRONT_PANEL_LIGHTS>(static_cast<uint32>(CurrentLightState) | LightsByIndex[ButtonIndex]);
-			}
-			else
-			{
-				CurrentLightState = static_cast<XBOX_FRONT_PANEL_LIGHTS>(static_cast<uint32>(CurrentLightState) & ~LightsByIndex[ButtonIndex]);
-			}
-			HRESULT SetLightStateResult = FrontPanel->SetLightStates(CurrentLightState);
-			if (FAILED(SetLightStateResult))
-			{
-				UE_LOG(LogXboxFrontPanel, Warning, TEXT("SetButtonLightState failed setting new light state: %08X"), SetLightStateResult);
-			}
-		}
-		else
-		{
-			UE_LOG(LogXboxFrontPanel, Warning, TEXT("SetButtonLightState failed reading existing light state: %08X"), GetLightStateResult);
-		}
+	// Tracked so that playing animations can keep the screen redrawing
+	RegisteredScreens[Name].UserWidget = Widget;
+	if (ActiveScreen == Name)
+	{
+		FrontScreenUserWidget = Widget;
 	}
+
+	return true;
 }
 
-bool FXboxFrontPanelModule::GetButtonLightState(EXboxFrontPanelButtonLight Light)
+void FXboxFrontPanelModule::UnregisterScreen(FName Name)
 {
-	if (FrontPanel != nullptr)
+	const FXboxFrontPanelRegisteredScreen* Screen = RegisteredScreens.Find(Name);
+	if (Screen == nullptr)
 	{
-		int32 ButtonIndex = static_cast<int32>(Light);
-		check(ButtonIndex < _countof(LightsByIndex));
+		return;
+	}
 
-		XBOX_FRONT_PANEL_LIGHTS CurrentLightState = XBOX_FRONT_PANEL_LIGHTS_NONE;
-		HRESULT GetLightStateResult = FrontPanel->GetLightStates(&CurrentLightState);
-		if (FAILED(GetLightStateResult))
-		{
-			UE_LOG(LogXboxFrontPanel, Warning, TEXT("GetButtonLightState failed reading existing light state: %08X"), GetLightStateResult);
-		}
-		return (CurrentLightState & LightsByIndex[ButtonIndex]) != 0;
+	if (ActiveScreen == Name)
+	{
+		DeactivateScreen();
 	}
 
-	return false;
+	{
+		FScopeLock Lock(&ScreenFrameCacheLock);
+		ScreenFrameCache.Remove(Screen->Id);
+	}
+
+	RegisteredScreens.Remove(Name);
 }
 
-void FXboxFrontPanelModule::SetScreenWidget(UUserWidget* Widget)
+bool FXboxFrontPanelModule::ShowScreen(FName Name)
 {
-	if (Widget)
+	const FXboxFrontPanelRegisteredScreen* Screen = RegisteredScreens.Find(Name);
+	if (Screen == nullptr)
 	{
-		SetScreenWidget(Widget->TakeWidget());
+		UE_LOG(LogXboxFrontPanel, Warning, TEXT("ShowScreen ignored: no screen is registered as %s."), *Name.ToString());
+		return false;
 	}
-	else
+
+	if (ActiveScreen == Name)
 	{
-		SetScreenWidget(TSharedPtr<SWidget>());
+		return true;
 	}
+
+	// Resources may have been released while no widget was showing
+	if (!InitScreenResources())
+	{
+		return false;
+	}
+
+	ActivateScreen(Name, Screen->Widget.ToSharedRef(), Screen->Window.ToSharedRef(), Screen->Id, Screen->bNeedsPrepass);
+	FrontScreenUserWidget = Screen->UserWidget;
+	return true;
 }
 
-void FXboxFrontPanelModule::SetScreenWidget(TSharedPtr<SWidget> Widget)
+FName FXboxFrontPanelModule::GetActiveScreen()
 {
-	if (Widget.IsValid())
+	return ActiveScreen;
+}
+
+void FXboxFrontPanelModule::ActivateScreen(FName Name, const TSharedRef<SWidget>& Widget, const TSharedRef<SVirtualWindow>& InWindow, int32 ScreenId, bool bNeedsPrepass)
+{
+	SaveActiveScreenLayoutState();
+	ScreenReleaseTime = 0.0;
+
+	// The widget takes the screen over from any canvas or animation
+	StopAnimation();
+	CanvasScreenData.Reset();
+	bCanvasPresentPending = false;
+
+	FrontScreenWidget = Widget;
+	ActiveWindow = InWindow;
+	ActiveScreen = Name;
+
+	WidgetRenderer.SetIsPrepassNeeded(bNeedsPrepass);
+	MarkScreenDirty();
+
+	SwitchScreenData(ScreenId);
+}
+
+void FXboxFrontPanelModule::DeactivateScreen()
+{
+	SaveActiveScreenLayoutState();
+
+	if (ActiveWindow == Window)
 	{
-		if (!InitScreenResources())
-		{
-			UE_LOG(LogXboxFrontPanel, Warning, TEXT("SetScreenWidget ignored: Xbox Front Panel screen is not supported."));
-			return;
-		}
+		Window->SetContent(SNullWidget::NullWidget);
+	}
 
-		check(Window.IsValid());
+	FrontScreenWidget.Reset();
+	FrontScreenUserWidget.Reset();
+	ActiveWindow.Reset();
+	ActiveScreen = NAME_None;
 
-		FrontScreenWidget = Widget;
-		Window->SetContent(FrontScreenWidget.ToSharedRef());
+	SwitchScreenData(ClearedScreenId);
 
-		// New widget needs a new prepass
-		WidgetRenderer.SetIsPrepassNeeded(true);
+	// Menu transitions often clear the widget only to set another one a moment later, so the resources outlive it
+	const float KeepAliveTime = CVarScreenKeepAliveTime.GetValueOnGameThread();
+	if (KeepAliveTime == 0.0f)
+	{
+		DeinitScreenResources();
 	}
-	else if (FrontScreenWidget.IsValid())
+	else
 	{
-		FrontScreenWidget.Reset();
+		ScreenReleaseTime = KeepAliveTime > 0.0f ? FPlatformTime::Seconds() + KeepAliveTime : 0.0;
+	}
+}
 
-		DeinitScreenResources();
+void FXboxFrontPanelModule::SaveActiveScreenLayoutState()
+{
+	// A page that has had its prepass keeps its layout in its own window, so showing it again skips the prepass
+	if (FXboxFrontPanelRegisteredScreen* Screen = RegisteredScreens.Find(ActiveScreen))
+	{
+		Screen->bNeedsPrepass = WidgetRenderer.GetIsPrepassNeeded();
 	}
 }
 
@@ -415,15 +1451,18 @@ bool FXboxFrontPanelModule::HandleKeyDownEvent(FSlateApplication& SlateApp, cons
 {
 	if (FrontScreenWidget.IsValid())
 	{
+		// Assume that any input the widget handles changes what it displays
 		FReply Reply = FrontScreenWidget->OnPreviewKeyDown(FrontScreenWidget->GetCachedGeometry(), InKeyEvent);
 		if (Reply.IsEventHandled())
 		{
+			MarkScreenDirty();
 			return true;
 		}
 
 		Reply = FrontScreenWidget->OnKeyDown(FrontScreenWidget->GetCachedGeometry(), InKeyEvent);
 		if (Reply.IsEventHandled())
 		{
+			MarkScreenDirty();
 			return true;
 		}
 	}
@@ -438,6 +1477,7 @@ bool FXboxFrontPanelModule::HandleKeyUpEvent(FSlateApplication& SlateApp, const
 		FReply Reply = FrontScreenWidget->OnKeyUp(FrontScreenWidget->GetCachedGeometry(), InKeyEvent);
 		if (Reply.IsEventHandled())
 		{
+			MarkScreenDirty();
 			return true;
 		}
 	}
@@ -445,43 +1485,49 @@ bool FXboxFrontPanelModule::HandleKeyUpEvent(FSlateApplication& SlateApp, const
 	return false;
 }
 
-bool FXboxFrontPanelModule::InitScreenResources()
+bool FXboxFrontPanelModule::QueryScreenInfo()
 {
-	if (Window.IsValid())
+	if (bScreenInfoValid)
 	{
-		// Already initialized
 		return true;
 	}
 
-	if (!FrontPanel)
+	if (!Device.IsValid())
 	{
 		// No front panel at all, no hope of a screen
 		return false;
 	}
 
-	// Validate that the front panel dimensions and format match
-	// the assumptions in DrawScreen_RenderThread. 
-	bool bCanUseFrontScreen = true;
-	bCanUseFrontScreen &= SUCCEEDED(FrontPanel->GetScreenWidth(&Width));
-	bCanUseFrontScreen &= SUCCEEDED(FrontPanel->GetScreenHeight(&Height));
+	// The device reports whether its screen is something the module can produce
+	bScreenInfoValid = Device->GetScreenInfo(Width, Height, ScreenFormat) && Width > 0 && Height > 0;
+	if (bScreenInfoValid)
+	{
+		if (ScreenFormat == EXboxFrontPanelScreenFormat::R1Threshold && CVarMonochromeDither.GetValueOnGameThread() != 0)
+		{
+			ScreenFormat = EXboxFrontPanelScreenFormat::R1Dithered;
+		}
+
+		ScreenRowBytes = FXboxFrontPanelLuminance::GetRowBytes(ScreenFormat, Width);
+		UE_LOG(LogXboxFrontPanel, Log, TEXT("Xbox Front Panel screen is %ux%u, %s, on the %s device."), Width, Height, FXboxFrontPanelLuminance::GetFormatName(ScreenFormat), Device->GetName());
+	}
+
+	return bScreenInfoValid;
+}
 
-	DXGI_FORMAT PlatformPixelFormat;
-	bCanUseFrontScreen &= SUCCEEDED(FrontPanel->GetScreenPixelFormat(&PlatformPixelFormat));
-	switch (PlatformPixelFormat)
+bool FXboxFrontPanelModule::InitScreenResources()
+{
+	if (Window.IsValid())
 	{
-	case DXGI_FORMAT_R8_TYPELESS:
-	case DXGI_FORMAT_R8_UNORM:
-	case DXGI_FORMAT_R8_UINT:
-		// We read and write 16 pixels at a time when calculating luminance on the CPU
-		bCanUseFrontScreen &= (Width % 16 == 0);
-		break;
-	default:
-		bCanUseFrontScreen = false;
-		break;
+		// Already initialized
+		return true;
 	}
 
+	const bool bCanUseFrontScreen = QueryScreenInfo();
 	if (bCanUseFrontScreen)
 	{
+		// Nothing here waits on the render thread: the render target resource and everything the render side owns are
+		// created by commands queued behind this call.  The render target needs no initial clear since DrawWindow
+		// clears it on every paint.
 		Window = SNew(SVirtualWindow).Size(FVector2D(Width, Height));
 		Window->Resize(FVector2D(Width, Height));
 
@@ -492,37 +1538,93 @@ bool FXboxFrontPanelModule::InitScreenResources()
 		RenderTarget->ClearColor = FLinearColor::Transparent;
 		RenderTarget->SRGB = false;
 		RenderTarget->TargetGamma = 1;
-		RenderTarget->InitCustomFormat(Width, Height, PF_B8G8R8A8, true);
-		RenderTarget->UpdateResourceImmediate(true);
+		const EXboxFrontPanelSourceFormat SourceFormat = static_cast<EXboxFrontPanelSourceFormat>(FMath::Clamp(CVarScreenSourceFormat.GetValueOnGameThread(), 0, static_cast<int32>(EXboxFrontPanelSourceFormat::Count) - 1));
+		RenderTarget->InitCustomFormat(Width, Height, GetSourcePixelFormat(SourceFormat), true);
 
 		WidgetRenderer.SetUseGammaCorrection(false);
 		WidgetRenderer.SetClearHitTestGrid(false);
 
 		// Schedule init for members owned by the render side
-		ENQUEUE_UNIQUE_RENDER_COMMAND_THREEPARAMETER(FXboxFrontPanelModule_InitScreenResources_RenderThread,
+		ENQUEUE_UNIQUE_RENDER_COMMAND_FOURPARAMETER(FXboxFrontPanelModule_InitScreenResources_RenderThread,
 			FXboxFrontPanelModule*, FrontPanelModule, this,
-			UINT32, Width, Width,
-			UINT32, Height, Height,
+			uint32, Width, Width,
+			uint32, Height, Height,
+			EXboxFrontPanelSourceFormat, SourceFormat, SourceFormat,
 			{
-				FrontPanelModule->CPUTexture[0] = nullptr;
-				FrontPanelModule->CPUTexture[1] = nullptr;
-				FrontPanelModule->CPUTextureIndex = 0;
+				FrontPanelModule->ScreenSourceFormat = SourceFormat;
+				FrontPanelModule->ScreenSourceBytesPerPixel = FXboxFrontPanelLuminance::GetSourceBytesPerPixel(SourceFormat);
+				const uint32 SourceFrameSize = Width * Height * FrontPanelModule->ScreenSourceBytesPerPixel;
+
+				// Created up front so the first paint does not have to
+				FrontPanelModule->ResizeReadbackRing_RenderThread(FMath::Clamp(CVarReadbackDepth.GetValueOnRenderThread(), 1, MaxReadbackDepth));
+				FrontPanelModule->bReadbackCopyPending = false;
+				FrontPanelModule->bReadbackBusy = false;
 
-				FrontPanelModule->FrontScreenDataSize = Width * Height;
-				FrontPanelModule->FrontScreenData.Reset(static_cast<BYTE*>(FMemory::Malloc(FrontPanelModule->FrontScreenDataSize, 16)));
+				FrontPanelModule->FrontScreenDataSize = FrontPanelModule->ScreenRowBytes * Height;
+				FrontPanelModule->FrontScreenData.Reset(static_cast<uint8*>(FMemory::Malloc(FrontPanelModule->FrontScreenDataSize, 16)));
+
+				FrontPanelModule->PreviousScreenSource.Reset(static_cast<uint8*>(FMemory::Malloc(SourceFrameSize, 16)));
+				FrontPanelModule->bPreviousScreenSourceValid = false;
+
+				if (CVarAsyncPresent.GetValueOnRenderThread() != 0)
+				{
+					// From here on the worker owns FrontScreenData and the previous frame until it is destroyed
+					FrontPanelModule->PresentWorker = MakeUnique<FXboxFrontPanelPresentWorker>(SourceFrameSize, AsyncPresentFrameCount,
+						[FrontPanelModule](const uint8* Frame, int32 ScreenId, double PaintTime)
+						{
+							if (Frame != nullptr)
+							{
+								FrontPanelModule->PresentScreenData(FrontPanelModule->ConvertChangedRows(Frame, FrontPanelModule->Width * FrontPanelModule->ScreenSourceBytesPerPixel), ScreenId, PaintTime);
+							}
+							else
+							{
+								FrontPanelModule->ShowScreenData(ScreenId);
+							}
+						});
+				}
 
 				// No need for initial zero or present.  The previous owner (whether us, or the system) should have ensured
 				// that the screen isn't presenting garbage.
 			});
 	}
-	else
-	{
-		UE_LOG(LogXboxFrontPanel, Warning, TEXT("Xbox Front Panel screen (width %d, pixel format %d) is not compatible with plugin render code."), Width, PlatformPixelFormat);
-	}
 
 	return bCanUseFrontScreen;
 }
 
+void FXboxFrontPanelModule::SwitchScreenData(int32 ScreenId)
+{
+	if (Window.IsValid())
+	{
+		if (ScreenId == ClearedScreenId)
+		{
+			PendingScreenClears.Increment();
+		}
+
+		ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(FXboxFrontPanelModule_SwitchScreenData_RenderThread,
+			FXboxFrontPanelModule*, FrontPanelModule, this,
+			int32, ScreenId, ScreenId,
+			{
+				// Copies still in flight hold the old widget.  They stay in the ring until their fences signal, since
+				// the GPU may still be writing their slots, and are dropped when they retire.
+				FrontPanelModule->bReadbackCopyPending = false;
+				FrontPanelModule->bReadbackBusy = FrontPanelModule->ReadbacksInFlight > 0;
+
+				FrontPanelModule->PresentingScreenId = ScreenId;
+				++FrontPanelModule->ScreenSwitchCount;
+
+				if (FrontPanelModule->PresentWorker.IsValid())
+				{
+					// Queued behind the frames already handed to the worker, so none of them can follow the switch
+					FrontPanelModule->PresentWorker->SubmitMarker(ScreenId);
+				}
+				else
+				{
+					FrontPanelModule->ShowScreenData(ScreenId);
+				}
+			});
+	}
+}
+
 void FXboxFrontPanelModule::DeinitScreenResources()
 {
 	if (Window.IsValid())
@@ -531,24 +1633,28 @@ void FXboxFrontPanelModule::DeinitScreenResources()
 
 		Window.Reset();
 		HitTestGrid.Reset();
+		ScreenReleaseTime = 0.0;
 
-		// Schedule deinit for members owned by the render side
+		// Schedule deinit for members owned by the render side.  The screen was cleared when the widget was.
 		ENQUEUE_UNIQUE_RENDER_COMMAND_ONEPARAMETER(FXboxFrontPanelModule_DeinitScreenResources_RenderThread,
 			FXboxFrontPanelModule*, FrontPanelModule, this,
 			{
-				// Clear the screen before cleaning up.
-				FMemory::Memzero(FrontPanelModule->FrontScreenData.Get(), FrontPanelModule->FrontScreenDataSize);
-				FrontPanelModule->FrontPanel->PresentBuffer(FrontPanelModule->FrontScreenDataSize, FrontPanelModule->FrontScreenData.Get());
+				// Stop the worker first so it is no longer touching FrontScreenData.  It delivers any clear still queued.
+				FrontPanelModule->PresentWorker.Reset();
 
 				FrontPanelModule->FrontScreenData.Reset();
 
-				FrontPanelModule->CPUTexture[0] = nullptr;
-				FrontPanelModule->CPUTexture[1] = nullptr;
-				FrontPanelModule->CPUTextureIndex = 0;
+				FrontPanelModule->PreviousScreenSource.Reset();
+				FrontPanelModule->bPreviousScreenSourceValid = false;
+
+				FrontPanelModule->ReadbackSlots.Reset();
+				FrontPanelModule->ReadbackReadIndex = 0;
+				FrontPanelModule->ReadbackWriteIndex = 0;
+				FrontPanelModule->ReadbacksInFlight = 0;
+				FrontPanelModule->bReadbackCopyPending = false;
+				FrontPanelModule->bReadbackBusy = false;
 			});
 	}
 }
 
-#include "XboxOneHidePlatformTypes.h"
-
-#endif // PLATFORM_XBOXONE
\ No newline at end of file
+#endif // FRONT_PANEL_ENABLED
\ No newline at end of file
@@ -9,6 +9,8 @@
 
 IMPLEMENT_MODULE(FXboxFrontPanelModule, XboxFrontPanel);
 
+DEFINE_LOG_CATEGORY(LogXboxFrontPanel);
+
 namespace XboxFrontPanelKeyNames
 {
 	const FGamepadKeyNames::Type Button1("Xbox_Front_Panel_Button_1");
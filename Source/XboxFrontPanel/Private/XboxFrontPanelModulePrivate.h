@@ -4,9 +4,16 @@
 #pragma once
 
 #include "XboxFrontPanelModule.h"
+#include "XboxFrontPanelLuminance.h"
+#include "XboxFrontPanelDevice.h"
+#include "XboxFrontPanelInput.h"
+#include "XboxFrontPanelCanvas.h"
 
 #include "InputCore.h"
 #include "SharedPointer.h"
+#include "XboxFrontPanelStats.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogXboxFrontPanel, Log, All);
 
 class FXboxFrontPanelModuleBase :
 	public IXboxFrontPanelModule
@@ -20,27 +27,67 @@ public:
 #include <xdk.h>
 #include "XboxOneHidePlatformTypes.h"
 
-#define FRONT_PANEL_ENABLED _XDK_EDITION >= 170600
+#define FRONT_PANEL_XDK_ENABLED _XDK_EDITION >= 170600
 #else
-#define FRONT_PANEL_ENABLED 0
+#define FRONT_PANEL_XDK_ENABLED 0
 #endif
 
+// The pipeline only talks to the panel through IXboxFrontPanelDevice, so outside of shipping builds it is compiled
+// everywhere and can drive the simulated device.
+#define FRONT_PANEL_ENABLED (FRONT_PANEL_XDK_ENABLED || !UE_BUILD_SHIPPING)
+
 #if FRONT_PANEL_ENABLED
 #include "Ticker.h"
-#include "Windows/ComPointer.h"
 #include "RenderUtils.h"
 #include "Slate/WidgetRenderer.h"
 #include "Framework/Application/IInputProcessor.h"
 #include "GenericApplicationMessageHandler.h"
-
-#include "XboxOneAllowPlatformTypes.h"
-#include <d3d11_x.h>
-#define DXGI_FORMAT_DEFINED
-#include <XboxFrontPanel.h>
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/CriticalSection.h"
+#include "XboxFrontPanelPresentWorker.h"
+#include "XboxFrontPanelButtonSampler.h"
+#include "XboxFrontPanelInputEngine.h"
+#include "XboxFrontPanelKeyFilter.h"
+#include "XboxFrontPanelAnimationPlayer.h"
+#include "XboxFrontPanelLatency.h"
+#include "XboxFrontPanelPerfHud.h"
 
 class UTextureRenderTarget2D;
 class SRetainerWidget;
 
+/** A light sequence started by PlayLightSequence. */
+struct FXboxFrontPanelActiveLightSequence
+{
+	UXboxFrontPanelLightSequence* Sequence;
+	int32 Priority;
+	double StartTime;
+};
+
+/** A staging surface for screen readback, plus the fence that signals once the GPU copy into it has finished. */
+struct FXboxFrontPanelReadbackSlot
+{
+	FTexture2DRHIRef Texture;
+	FGPUFenceRHIRef Fence;
+
+	// When the paint copied into Texture was made
+	double PaintTime;
+
+	// ScreenSwitchCount when the copy was made.  Copies from before a screen switch are dropped as they retire.
+	uint32 SwitchCount;
+};
+
+/** A page added with RegisterScreen.  Its own window keeps the widget's layout while other pages are shown. */
+struct FXboxFrontPanelRegisteredScreen
+{
+	// Tags the page's frames on the render side, see ScreenFrameCache
+	int32 Id;
+	TSharedPtr<SWidget> Widget;
+	TWeakObjectPtr<UUserWidget> UserWidget;
+	TSharedPtr<SVirtualWindow> Window;
+	bool bNeedsPrepass;
+};
+
 class FXboxFrontPanelModule :
 	public FXboxFrontPanelModuleBase,
 	public FGCObject,
@@ -51,14 +98,41 @@ public:
 
 public:
 	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
 
 public:
 	virtual bool IsFrontPanelAvailable();
 	virtual void SetButtonLightState(EXboxFrontPanelButtonLight Light, bool OnOff);
 	virtual bool GetButtonLightState(EXboxFrontPanelButtonLight Light);
+	virtual void SetButtonLightMask(int32 Mask);
+	virtual int32 GetButtonLightMask();
+
+	virtual void PlayLightSequence(UXboxFrontPanelLightSequence* Sequence);
+	virtual void StopLightSequence(UXboxFrontPanelLightSequence* Sequence);
+	virtual void StopAllLightSequences();
 
 	virtual void SetScreenWidget(TSharedPtr<SWidget> Widget);
 	virtual void SetScreenWidget(UUserWidget* Widget);
+	virtual void MarkScreenDirty();
+	virtual bool PrewarmScreen();
+
+	virtual bool RegisterScreen(FName Name, TSharedPtr<SWidget> Widget);
+	virtual bool RegisterScreen(FName Name, UUserWidget* Widget);
+	virtual void UnregisterScreen(FName Name);
+	virtual bool ShowScreen(FName Name);
+	virtual FName GetActiveScreen();
+
+	virtual FIntPoint GetScreenSize();
+	virtual bool PresentCanvas(const FXboxFrontPanelCanvas& Canvas);
+
+	virtual bool PlayAnimation(const FString& Filename, bool bLoop);
+	virtual void StopAnimation();
+	virtual bool IsAnimationPlaying();
+
+	virtual IXboxFrontPanelDevice* GetDevice();
+
+	virtual void SetInputConfig(const FXboxFrontPanelInputConfig& Config);
+	virtual const FXboxFrontPanelInputConfig& GetInputConfig();
 
 public:
 	bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent);
@@ -70,44 +144,160 @@ public:
 public:
 	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
 
-	void DrawScreen_RenderThread(FRHICommandListImmediate& RHICmdList, FTextureRenderTargetResource* GpuProducedScreenTexture);
+	void DrawScreen_RenderThread(FRHICommandListImmediate& RHICmdList, FTextureRenderTargetResource* GpuProducedScreenTexture, bool bScreenPainted, double PaintTime);
 
 private:
 
 	void DrawScreen_GameThread(float DeltaTime);
+	bool IsScreenRedrawNeeded() const;
+
+	void PresentCompletedReadback_RenderThread();
+	void WaitForNewestReadback_RenderThread(FRHICommandListImmediate& RHICmdList);
+	void ResizeReadbackRing_RenderThread(int32 Depth);
+	// Called on the render thread, or on the present worker when XboxFrontPanel.AsyncPresent is set
+	bool ConvertChangedRows(const uint8* Src, uint32 SrcPitch);
+	void PresentScreenData(bool bScreenChanged, int32 ScreenId, double PaintTime);
+	void ShowScreenData(int32 ScreenId);
+
+	void PresentPendingCanvas();
+	void TickAnimation();
+
+	void SetPerfHudShown(bool bShown);
+	void TickPerfHud(float DeltaTime);
 
 	void GenerateButtonEvents();
-	void GenerateSingleButtonEvent(int32 NewState, int32 LastState, FGamepadKeyNames::Type KeyName, double CurrentTime, double& RepeatAt);
+	void CommitLightStates();
+	EXboxFrontPanelLights EvaluateLightSequences(double CurrentTime);
 
+	bool QueryScreenInfo();
 	bool InitScreenResources();
+	void SwitchScreenData(int32 ScreenId);
 	void DeinitScreenResources();
 
+	void ActivateScreen(FName Name, const TSharedRef<SWidget>& Widget, const TSharedRef<SVirtualWindow>& InWindow, int32 ScreenId, bool bNeedsPrepass);
+	void DeactivateScreen();
+	void SaveActiveScreenLayoutState();
+
 public:
-	TComPtr<IXboxFrontPanelControl> FrontPanel;
+	// Null when there is no panel, real or simulated
+	TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> Device;
 
-	TUniquePtr<BYTE[]> FrontScreenData;
-	uint64 FrontScreenDataSize;
+	TUniquePtr<uint8[]> FrontScreenData;
+	uint32 FrontScreenDataSize;
 
+	// Exist from PrewarmScreen or the first screen widget until XboxFrontPanel.ScreenKeepAliveTime after the widget is cleared
 	TSharedPtr<FHittestGrid> HitTestGrid;
 	TSharedPtr<SVirtualWindow> Window;
+	// Window DrawWindow paints: Window for SetScreenWidget, or the shown page's own window
+	TSharedPtr<SVirtualWindow> ActiveWindow;
 	TSharedPtr<SWidget> FrontScreenWidget;
+	TWeakObjectPtr<UUserWidget> FrontScreenUserWidget;
+
+	// Pages for ShowScreen.  ActiveScreen is NAME_None unless one of them is showing.
+	TMap<FName, FXboxFrontPanelRegisteredScreen> RegisteredScreens;
+	FName ActiveScreen;
+	int32 NextScreenId;
+
+	// Last frame presented for each registered page, in the panel's format, keyed by page id.  Written by whichever
+	// thread presents and read when a page is shown again, so guarded by its lock.
+	TMap<int32, TArray<uint8>> ScreenFrameCache;
+	FCriticalSection ScreenFrameCacheLock;
+
+	// Page new readbacks are made for, and the number of screen switches so far.  Render thread only.
+	int32 PresentingScreenId;
+	uint32 ScreenSwitchCount;
 	FWidgetRenderer WidgetRenderer;
 
 	UTextureRenderTarget2D* RenderTarget;
-	FTexture2DRHIRef CPUTexture[2];
-	int32 CPUTextureIndex;
+	// Ring of staging surfaces owned by the render thread.  Slots from ReadbackReadIndex onward are in flight.
+	TArray<FXboxFrontPanelReadbackSlot> ReadbackSlots;
+	int32 ReadbackReadIndex;
+	int32 ReadbackWriteIndex;
+	int32 ReadbacksInFlight;
+	bool bReadbackCopyPending;
 
-	UINT32 Width;
-	UINT32 Height;
+	// When the paint now in the render target was made.  Render thread only.
+	double RenderTargetPaintTime;
 
-	XBOX_FRONT_PANEL_BUTTONS LastButtonStates;
-	double NextButtonRepeatTime[10];
+	// Set by the render thread while a paint has yet to reach the panel
+	FThreadSafeBool bReadbackBusy;
 
-	static const double InitialButtonRepeatDelay;
-	static const double ButtonRepeatDelay;
-};
+	// Created by the render thread when conversion and present run asynchronously
+	TUniquePtr<FXboxFrontPanelPresentWorker> PresentWorker;
 
-#include "XboxOneHidePlatformTypes.h"
+	// Copy of the last frame read back, used to find the rows that actually changed.
+	TUniquePtr<uint8[]> PreviousScreenSource;
+	bool bPreviousScreenSourceValid;
+	EXboxFrontPanelLuminanceKernel PreviousScreenKernel;
+	EXboxFrontPanelLuminanceMode PreviousScreenMode;
+
+	uint32 Width;
+	uint32 Height;
+	bool bScreenInfoValid;
+
+	// Layout of FrontScreenData, chosen from the panel's pixel format
+	EXboxFrontPanelScreenFormat ScreenFormat;
+	uint32 ScreenRowBytes;
+
+	// Layout of the render target and staging surfaces.  Owned by the render side, from XboxFrontPanel.ScreenSourceFormat.
+	EXboxFrontPanelSourceFormat ScreenSourceFormat;
+	uint32 ScreenSourceBytesPerPixel;
+
+	// Last canvas packed by PresentCanvas, in the panel's format.  Game thread only.
+	TArray<uint8> CanvasScreenData;
+	bool bCanvasPresentPending;
+
+	// Streams into CanvasScreenData, or into AnimationFrame first when the panel needs packing
+	TUniquePtr<FXboxFrontPanelAnimationPlayer> AnimationPlayer;
+	TArray<uint8> AnimationFrame;
+	double AnimationStartTime;
+
+	// Exists while XboxFrontPanel.PerfHud is set.  Game thread only.
+	TUniquePtr<FXboxFrontPanelPerfHud> PerfHud;
+	TArray<uint8> PerfHudScreenData;
+
+	// Held around every PresentBuffer, since the game thread, the render thread and the present worker all present.
+	// bPerfHudShown is only changed under it, so no widget frame can follow the HUD onto the screen.
+	FCriticalSection PresentLock;
+	bool bPerfHudShown;
+
+	// Screen clears queued to the render thread by SwitchScreenData.  A canvas waits for them so that it is not
+	// wiped as soon as it is shown.
+	FThreadSafeCounter PendingScreenClears;
+
+	// Game thread redraw tracking, see XboxFrontPanel.RedrawMode
+	bool bScreenDirty;
+	float PendingRedrawDeltaTime;
+	double LastRedrawTime;
+
+	// When Tick releases the screen resources kept after the widget was cleared.  0 while they are in use or kept.
+	double ScreenReleaseTime;
+
+	// Created on the game thread while XboxFrontPanel.ButtonSampleRate is non-zero
+	TUniquePtr<FXboxFrontPanelButtonSampler> ButtonSampler;
+
+	FXboxFrontPanelInputEngine InputEngine;
+
+	// Which key events HandleKeyDownEvent and HandleKeyUpEvent see, kept in step with InputEngine's config
+	FXboxFrontPanelKeyFilter KeyFilter;
+
+	// Registered with Slate while there is a device
+	TSharedPtr<IInputProcessor> InputProcessor;
+
+	// Follows button presses through to the panel, see XboxFrontPanel.DumpLatency
+	FXboxFrontPanelLatencyTracker LatencyTracker;
+
+	// Authoritative light state.  Game code only changes LightShadow; CommitLightStates sends it to the device once
+	// per tick when it differs from what the device was last given.
+	EXboxFrontPanelLights LightShadow;
+	EXboxFrontPanelLights CommittedLights;
+
+	// Bound at startup while XboxFrontPanel.PrewarmScreen is set
+	FDelegateHandle PostEngineInitHandle;
+
+	// Highest priority first.  Among equal priorities the most recently played comes first.
+	TArray<FXboxFrontPanelActiveLightSequence> ActiveLightSequences;
+};
 
 #else
 
@@ -117,9 +307,35 @@ class FXboxFrontPanelModule :
 	virtual bool IsFrontPanelAvailable() { return false; }
 	virtual void SetButtonLightState(EXboxFrontPanelButtonLight Light, bool OnOff) {}
 	virtual bool GetButtonLightState(EXboxFrontPanelButtonLight Light) { return false; }
+	virtual void SetButtonLightMask(int32 Mask) {}
+	virtual int32 GetButtonLightMask() { return 0; }
+
+	virtual void PlayLightSequence(UXboxFrontPanelLightSequence* Sequence) {}
+	virtual void StopLightSequence(UXboxFrontPanelLightSequence* Sequence) {}
+	virtual void StopAllLightSequences() {}
 
 	virtual void SetScreenWidget(TSharedPtr<SWidget> Widget) {}
 	virtual void SetScreenWidget(UUserWidget* Widget) {}
+	virtual void MarkScreenDirty() {}
+	virtual bool PrewarmScreen() { return false; }
+
+	virtual bool RegisterScreen(FName Name, TSharedPtr<SWidget> Widget) { return false; }
+	virtual bool RegisterScreen(FName Name, UUserWidget* Widget) { return false; }
+	virtual void UnregisterScreen(FName Name) {}
+	virtual bool ShowScreen(FName Name) { return false; }
+	virtual FName GetActiveScreen() { return NAME_None; }
+
+	virtual FIntPoint GetScreenSize() { return FIntPoint::ZeroValue; }
+	virtual bool PresentCanvas(const FXboxFrontPanelCanvas& Canvas) { return false; }
+
+	virtual bool PlayAnimation(const FString& Filename, bool bLoop) { return false; }
+	virtual void StopAnimation() {}
+	virtual bool IsAnimationPlaying() { return false; }
+
+	virtual IXboxFrontPanelDevice* GetDevice() { return nullptr; }
+
+	virtual void SetInputConfig(const FXboxFrontPanelInputConfig& Config) {}
+	virtual const FXboxFrontPanelInputConfig& GetInputConfig() { static const FXboxFrontPanelInputConfig DefaultConfig; return DefaultConfig; }
 };
 
 #endif
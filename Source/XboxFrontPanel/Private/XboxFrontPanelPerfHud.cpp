@@ -0,0 +1,320 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelPerfHud.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "RenderCore.h"
+#include "RHI.h"
+
+static TAutoConsoleVariable<float> CVarPerfHudSampleRate(
+	TEXT("XboxFrontPanel.PerfHud.SampleRate"),
+	10.0f,
+	TEXT("Samples per second taken by the front panel performance HUD.  Each sample is one column of its graph."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPerfHudGraphMaxTime(
+	TEXT("XboxFrontPanel.PerfHud.GraphMaxTime"),
+	50.0f,
+	TEXT("Frame time in milliseconds at the top of the front panel performance HUD graph."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPerfHudTargetFrameTime(
+	TEXT("XboxFrontPanel.PerfHud.TargetFrameTime"),
+	16.67f,
+	TEXT("Frame time in milliseconds marked by a line across the front panel performance HUD graph."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPerfHudHitchTime(
+	TEXT("XboxFrontPanel.PerfHud.HitchTime"),
+	60.0f,
+	TEXT("Frames longer than this many milliseconds count as hitches on the front panel performance HUD."),
+	ECVF_Default);
+
+namespace XboxFrontPanelPerfHud
+{
+	// Built-in 3x5 font, ' ' to 'Z'.  One octal digit per row, top row first, most significant bit on the left.
+	static const uint16 Glyphs[] =
+	{
+		0, 0, 0, 0, 0, 051245, 0, 0,
+		024442, 021112, 0, 002720, 0, 000700, 000002, 011244,
+		075557, 026227, 071747, 071717, 055711, 074717, 074757, 071111,
+		075757, 075717, 002020, 0, 012421, 007070, 042124, 0,
+		0, 025755, 065656, 034443, 065556, 074647, 074644, 034553,
+		055755, 072227, 011152, 055655, 044447, 057755, 065555, 025552,
+		065644, 025563, 065655, 034216, 072222, 055557, 055552, 055775,
+		055255, 055222, 071247,
+	};
+	static const TCHAR FirstGlyph = TEXT(' ');
+
+	static const int32 GlyphWidth = 3;
+	static const int32 GlyphHeight = 5;
+	static const int32 GlyphAdvance = 4;
+	static const int32 LineHeight = 7;
+	static const int32 TextLines = 2;
+
+	// Luminance of each element
+	static const uint8 TextValue = 255;
+	static const uint8 SeparatorValue = 48;
+	static const uint8 AreaValue = 40;
+	static const uint8 SpikeValue = 96;
+	static const uint8 TargetValue = 64;
+	static const uint8 LineValue = 255;
+
+	static void DrawText(FXboxFrontPanelCanvas& Canvas, const FString& Text, FIntPoint Position)
+	{
+		int32 X = Position.X;
+		for (TCHAR Character : Text)
+		{
+			const TCHAR Upper = FChar::ToUpper(Character);
+			const int32 Index = Upper - FirstGlyph;
+			const uint16 Glyph = Index >= 0 && Index < static_cast<int32>(ARRAY_COUNT(Glyphs)) ? Glyphs[Index] : 0;
+			for (int32 Row = 0; Row < GlyphHeight; ++Row)
+			{
+				const uint32 Bits = (Glyph >> ((GlyphHeight - 1 - Row) * GlyphWidth)) & 7;
+				for (int32 Column = 0; Column < GlyphWidth; ++Column)
+				{
+					if (Bits & (4 >> Column))
+					{
+						Canvas.SetPixel(X + Column, Position.Y + Row, TextValue);
+					}
+				}
+			}
+			X += GlyphAdvance;
+		}
+	}
+}
+
+FXboxFrontPanelPerfHud::FXboxFrontPanelPerfHud(int32 Width, int32 Height)
+	: Canvas(Width, Height)
+	, NewestSample(0)
+	, GraphMaxTime(0.0f)
+	, TargetFrameTime(0.0f)
+	, NextSampleTime(0.0)
+	, LastSampleTime(FPlatformTime::Seconds())
+	, PendingFrames(0)
+	, PendingFrameTime(0.0f)
+	, PendingMaxFrameTime(0.0f)
+	, PendingGameThreadCycles(0)
+	, PendingRenderThreadCycles(0)
+	, PendingGpuCycles(0)
+	, bPendingHitch(false)
+	, HitchCount(0)
+{
+	using namespace XboxFrontPanelPerfHud;
+
+	// Text on top, separated from the graph below it by a dim line
+	const int32 GraphTop = FMath::Min(TextLines * LineHeight + 1, Height);
+	GraphRect = FIntRect(0, GraphTop, Width, Height);
+	if (GraphTop > 0)
+	{
+		Canvas.FillRect(FIntRect(0, GraphTop - 1, Width, GraphTop), SeparatorValue);
+	}
+
+	FSample Empty;
+	FMemory::Memzero(Empty);
+	Samples.Init(Empty, FMath::Max(Width, 0) + 1);
+}
+
+void FXboxFrontPanelPerfHud::AddFrame(float DeltaTime)
+{
+	const float FrameTime = DeltaTime * 1000.0f;
+	++PendingFrames;
+	PendingFrameTime += FrameTime;
+	PendingMaxFrameTime = FMath::Max(PendingMaxFrameTime, FrameTime);
+	PendingGameThreadCycles += GGameThreadTime;
+	PendingRenderThreadCycles += GRenderThreadTime;
+	PendingGpuCycles += RHIGetGPUFrameCycles();
+
+	if (FrameTime > CVarPerfHudHitchTime.GetValueOnGameThread())
+	{
+		++HitchCount;
+		bPendingHitch = true;
+	}
+}
+
+FXboxFrontPanelPerfHud::FSample FXboxFrontPanelPerfHud::TakeSample(double CurrentTime)
+{
+	FSample Sample;
+	FMemory::Memzero(Sample);
+
+	if (PendingFrames > 0)
+	{
+		const uint64 Frames = PendingFrames;
+		Sample.FrameTime = PendingFrameTime / PendingFrames;
+		Sample.MaxFrameTime = PendingMaxFrameTime;
+		Sample.GameThreadTime = FPlatformTime::ToMilliseconds(static_cast<uint32>(PendingGameThreadCycles / Frames));
+		Sample.RenderThreadTime = FPlatformTime::ToMilliseconds(static_cast<uint32>(PendingRenderThreadCycles / Frames));
+		Sample.GpuTime = FPlatformTime::ToMilliseconds(static_cast<uint32>(PendingGpuCycles / Frames));
+		Sample.FramesPerSecond = static_cast<float>(PendingFrames / FMath::Max(CurrentTime - LastSampleTime, 1.0e-3));
+		Sample.bHitch = bPendingHitch;
+		Sample.bValid = true;
+	}
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	Sample.UsedMemoryMB = static_cast<uint32>(MemoryStats.UsedPhysical >> 20);
+	Sample.TotalMemoryMB = static_cast<uint32>(MemoryStats.TotalPhysical >> 20);
+
+	LastSampleTime = CurrentTime;
+	PendingFrames = 0;
+	PendingFrameTime = 0.0f;
+	PendingMaxFrameTime = 0.0f;
+	PendingGameThreadCycles = 0;
+	PendingRenderThreadCycles = 0;
+	PendingGpuCycles = 0;
+	bPendingHitch = false;
+
+	return Sample;
+}
+
+bool FXboxFrontPanelPerfHud::Update(double CurrentTime)
+{
+	if (CurrentTime < NextSampleTime)
+	{
+		return false;
+	}
+
+	const float SampleRate = FMath::Clamp(CVarPerfHudSampleRate.GetValueOnGameThread(), 0.1f, 120.0f);
+	NextSampleTime = CurrentTime + 1.0 / SampleRate;
+
+	NewestSample = (NewestSample + 1) % Samples.Num();
+	Samples[NewestSample] = TakeSample(CurrentTime);
+	const FSample& Sample = Samples[NewestSample];
+
+	const float NewGraphMaxTime = FMath::Max(CVarPerfHudGraphMaxTime.GetValueOnGameThread(), 1.0f);
+	const float NewTargetFrameTime = CVarPerfHudTargetFrameTime.GetValueOnGameThread();
+	if (NewGraphMaxTime != GraphMaxTime || NewTargetFrameTime != TargetFrameTime)
+	{
+		GraphMaxTime = NewGraphMaxTime;
+		TargetFrameTime = NewTargetFrameTime;
+		RedrawGraph();
+	}
+	else
+	{
+		ScrollGraph();
+	}
+
+	// Worst frame anywhere on the graph, which is every sample but the oldest
+	const int32 OldestSample = (NewestSample + 1) % Samples.Num();
+	float PeakFrameTime = 0.0f;
+	for (int32 Index = 0; Index < Samples.Num(); ++Index)
+	{
+		if (Index != OldestSample)
+		{
+			PeakFrameTime = FMath::Max(PeakFrameTime, Samples[Index].MaxFrameTime);
+		}
+	}
+
+	DrawTextLine(0, FString::Printf(TEXT("FPS %4.1f  FRAME %4.1f  GAME %4.1f  DRAW %4.1f  GPU %4.1f"),
+		Sample.FramesPerSecond, Sample.FrameTime, Sample.GameThreadTime, Sample.RenderThreadTime, Sample.GpuTime));
+	DrawTextLine(1, FString::Printf(TEXT("MEM %u/%uM  HITCHES %u  PEAK %.1fMS"),
+		Sample.UsedMemoryMB, Sample.TotalMemoryMB, HitchCount, PeakFrameTime));
+
+	return true;
+}
+
+void FXboxFrontPanelPerfHud::DrawTextLine(int32 Line, const FString& Text)
+{
+	using namespace XboxFrontPanelPerfHud;
+
+	if (Text == DrawnText[Line])
+	{
+		return;
+	}
+
+	const int32 Top = Line * LineHeight;
+	Canvas.FillRect(FIntRect(0, Top, Canvas.GetWidth(), FMath::Min(Top + LineHeight, GraphRect.Min.Y - 1)), 0);
+	DrawText(Canvas, Text, FIntPoint(1, Top + 1));
+	DrawnText[Line] = Text;
+}
+
+int32 FXboxFrontPanelPerfHud::GetGraphY(float Milliseconds) const
+{
+	const int32 GraphHeight = GraphRect.Height();
+	const int32 Rows = FMath::RoundToInt(Milliseconds / GraphMaxTime * (GraphHeight - 1));
+	return GraphRect.Max.Y - 1 - FMath::Clamp(Rows, 0, GraphHeight - 1);
+}
+
+void FXboxFrontPanelPerfHud::RedrawGraph()
+{
+	if (GraphRect.Height() <= 0)
+	{
+		return;
+	}
+
+	// The newest sample is in the rightmost column
+	const int32 Count = Samples.Num();
+	for (int32 X = GraphRect.Min.X; X < GraphRect.Max.X; ++X)
+	{
+		const int32 Age = GraphRect.Max.X - 1 - X;
+		const int32 Index = (NewestSample - Age + Count * 2) % Count;
+		DrawColumn(X, Samples[Index], Samples[(Index + Count - 1) % Count]);
+	}
+}
+
+void FXboxFrontPanelPerfHud::ScrollGraph()
+{
+	if (GraphRect.Height() <= 0)
+	{
+		return;
+	}
+
+	const int32 Pitch = Canvas.GetPitch();
+	uint8* Row = Canvas.GetData() + GraphRect.Min.Y * Pitch + GraphRect.Min.X;
+	for (int32 Y = GraphRect.Min.Y; Y < GraphRect.Max.Y; ++Y, Row += Pitch)
+	{
+		FMemory::Memmove(Row, Row + 1, GraphRect.Width() - 1);
+	}
+
+	const int32 Count = Samples.Num();
+	DrawColumn(GraphRect.Max.X - 1, Samples[NewestSample], Samples[(NewestSample + Count - 1) % Count]);
+}
+
+void FXboxFrontPanelPerfHud::DrawColumn(int32 X, const FSample& Sample, const FSample& Previous)
+{
+	using namespace XboxFrontPanelPerfHud;
+
+	const int32 Pitch = Canvas.GetPitch();
+	uint8* Column = Canvas.GetData() + X;
+	for (int32 Y = GraphRect.Min.Y; Y < GraphRect.Max.Y; ++Y)
+	{
+		Column[Y * Pitch] = 0;
+	}
+
+	if (TargetFrameTime > 0.0f && TargetFrameTime < GraphMaxTime)
+	{
+		Column[GetGraphY(TargetFrameTime) * Pitch] = TargetValue;
+	}
+
+	if (!Sample.bValid)
+	{
+		return;
+	}
+
+	// Average frame time as a filled line, with the worst frame of the sample as a dimmer spike above it
+	const int32 AverageY = GetGraphY(Sample.FrameTime);
+	const int32 MaxY = GetGraphY(Sample.MaxFrameTime);
+	for (int32 Y = AverageY + 1; Y < GraphRect.Max.Y; ++Y)
+	{
+		Column[Y * Pitch] = FMath::Max(Column[Y * Pitch], AreaValue);
+	}
+	for (int32 Y = MaxY; Y < AverageY; ++Y)
+	{
+		Column[Y * Pitch] = SpikeValue;
+	}
+
+	// Join the line to the previous column so steep changes stay connected
+	const int32 PreviousY = Previous.bValid ? GetGraphY(Previous.FrameTime) : AverageY;
+	for (int32 Y = FMath::Min(PreviousY, AverageY); Y <= FMath::Max(PreviousY, AverageY); ++Y)
+	{
+		Column[Y * Pitch] = LineValue;
+	}
+
+	if (Sample.bHitch)
+	{
+		Column[GraphRect.Min.Y * Pitch] = LineValue;
+	}
+}
@@ -0,0 +1,92 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "XboxFrontPanelCanvas.h"
+
+/**
+* Performance monitor drawn on the front panel screen while XboxFrontPanel.PerfHud is set, so a test kit can watch
+* frame rate, thread and GPU times, memory and hitches without anything on the TV image.
+*
+* Every frame adds a few numbers to running totals.  At XboxFrontPanel.PerfHud.SampleRate those totals become one
+* sample in a ring holding a sample per graph column.  Drawing is incremental: the graph scrolls left by one column
+* and only the new column is drawn, and a text line is only redrawn when its contents change.  The built-in 3x5
+* pixel font needs no font asset.
+*
+* Game thread only.
+*/
+class FXboxFrontPanelPerfHud
+{
+public:
+	FXboxFrontPanelPerfHud(int32 Width, int32 Height);
+
+	/** Account for one game frame that took DeltaTime seconds. */
+	void AddFrame(float DeltaTime);
+
+	/**
+	* Take a sample and draw it if one is due.
+	*
+	* @return		True if the canvas changed and should be presented.
+	*/
+	bool Update(double CurrentTime);
+
+	const FXboxFrontPanelCanvas& GetCanvas() const { return Canvas; }
+
+private:
+	struct FSample
+	{
+		float FrameTime;
+		float MaxFrameTime;
+		float GameThreadTime;
+		float RenderThreadTime;
+		float GpuTime;
+		float FramesPerSecond;
+		uint32 UsedMemoryMB;
+		uint32 TotalMemoryMB;
+		bool bHitch;
+		bool bValid;
+	};
+
+	FSample TakeSample(double CurrentTime);
+
+	/** Redraw every graph column from the ring, after the graph scale changes. */
+	void RedrawGraph();
+
+	/** Shift the graph left one column and draw the newest sample in the freed column. */
+	void ScrollGraph();
+
+	void DrawColumn(int32 X, const FSample& Sample, const FSample& Previous);
+	void DrawTextLine(int32 Line, const FString& Text);
+
+	// Rows of the graph for a time in milliseconds, clamped to the graph
+	int32 GetGraphY(float Milliseconds) const;
+
+	FXboxFrontPanelCanvas Canvas;
+	FIntRect GraphRect;
+
+	// One sample per graph column, the newest at NewestSample, and one more for the leftmost column's line to join
+	TArray<FSample> Samples;
+	int32 NewestSample;
+
+	// Graph settings the drawn columns were made with
+	float GraphMaxTime;
+	float TargetFrameTime;
+
+	FString DrawnText[2];
+
+	double NextSampleTime;
+	double LastSampleTime;
+
+	// Totals since the last sample
+	int32 PendingFrames;
+	float PendingFrameTime;
+	float PendingMaxFrameTime;
+	uint64 PendingGameThreadCycles;
+	uint64 PendingRenderThreadCycles;
+	uint64 PendingGpuCycles;
+	bool bPendingHitch;
+
+	uint32 HitchCount;
+};
@@ -0,0 +1,129 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelPresentWorker.h"
+#include "XboxFrontPanelModulePrivate.h"
+
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Async Frames Superseded"), STAT_XboxFrontPanel_AsyncFramesSuperseded, STATGROUP_XboxFrontPanel);
+
+FXboxFrontPanelPresentWorker::FXboxFrontPanelPresentWorker(uint32 InFrameSize, int32 NumFrames, FPresentFunction InPresent)
+	: FrameSize(InFrameSize)
+	, Present(MoveTemp(InPresent))
+	, FrameReadyEvent(FPlatformProcess::GetSynchEventFromPool(false))
+	, bStopping(false)
+	, Thread(nullptr)
+{
+	check(NumFrames > 0);
+
+	// Filled before the thread starts, so the worker is still the only producer of FreeFrames once running.
+	Frames.Reserve(NumFrames);
+	for (int32 Index = 0; Index < NumFrames; ++Index)
+	{
+		uint8* Frame = static_cast<uint8*>(FMemory::Malloc(FrameSize, 16));
+		Frames.Add(Frame);
+		FreeFrames.Enqueue(Frame);
+	}
+
+	Thread = FRunnableThread::Create(this, TEXT("XboxFrontPanelPresent"), 0, TPri_Lowest);
+}
+
+FXboxFrontPanelPresentWorker::~FXboxFrontPanelPresentWorker()
+{
+	if (Thread != nullptr)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(FrameReadyEvent);
+	FrameReadyEvent = nullptr;
+
+	for (uint8* Frame : Frames)
+	{
+		FMemory::Free(Frame);
+	}
+}
+
+uint8* FXboxFrontPanelPresentWorker::AcquireFrame()
+{
+	uint8* Frame = nullptr;
+	FreeFrames.Dequeue(Frame);
+	return Frame;
+}
+
+void FXboxFrontPanelPresentWorker::SubmitFrame(uint8* Frame, int32 Tag, double PaintTime)
+{
+	check(Frame != nullptr);
+	PendingFrames.Enqueue(FPendingFrame{ Frame, Tag, PaintTime });
+	FrameReadyEvent->Trigger();
+}
+
+void FXboxFrontPanelPresentWorker::SubmitMarker(int32 Tag)
+{
+	PendingFrames.Enqueue(FPendingFrame{ nullptr, Tag, 0.0 });
+	FrameReadyEvent->Trigger();
+}
+
+uint32 FXboxFrontPanelPresentWorker::Run()
+{
+	// Once stopping, keep going until the queue is empty so that a marker submitted before Stop is not lost
+	do
+	{
+		if (!bStopping)
+		{
+			FrameReadyEvent->Wait();
+		}
+
+		// Newest frame wins.  Anything older that queued up while we were busy goes straight back to the pool.  Markers
+		// are never skipped; each one drops the frames queued before it.
+		uint8* NewestFrame = nullptr;
+		int32 NewestTag = 0;
+		double NewestPaintTime = 0.0;
+		FPendingFrame Pending;
+		while (PendingFrames.Dequeue(Pending))
+		{
+			if (NewestFrame != nullptr)
+			{
+				FreeFrames.Enqueue(NewestFrame);
+				INC_DWORD_STAT(STAT_XboxFrontPanel_AsyncFramesSuperseded);
+				NewestFrame = nullptr;
+			}
+
+			if (Pending.Frame == nullptr)
+			{
+				Present(nullptr, Pending.Tag, 0.0);
+			}
+			else
+			{
+				NewestFrame = Pending.Frame;
+				NewestTag = Pending.Tag;
+				NewestPaintTime = Pending.PaintTime;
+			}
+		}
+
+		if (NewestFrame != nullptr)
+		{
+			if (!bStopping)
+			{
+				SCOPED_NAMED_EVENT(FXboxFrontPanelPresentWorker_Present, FColor::Turquoise);
+				Present(NewestFrame, NewestTag, NewestPaintTime);
+			}
+			FreeFrames.Enqueue(NewestFrame);
+		}
+	}
+	while (!bStopping || !PendingFrames.IsEmpty());
+
+	return 0;
+}
+
+void FXboxFrontPanelPresentWorker::Stop()
+{
+	bStopping = true;
+	FrameReadyEvent->Trigger();
+}
@@ -0,0 +1,81 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Containers/Queue.h"
+
+class FRunnableThread;
+class FEvent;
+
+/**
+* Low priority thread that takes frames read back by the render thread and converts and presents them
+* to the front panel, keeping that work off the render thread's critical path.
+*
+* Frames move between the render thread and the worker through two single-producer/single-consumer queues
+* over a fixed pool of buffers, so nothing is allocated per frame beyond queue nodes and neither side blocks.
+* When the worker falls behind it presents only the newest queued frame.  A marker is queued like a frame, so it
+* supersedes the frames queued before it and is never overtaken by them.
+*/
+class FXboxFrontPanelPresentWorker :
+	public FRunnable
+{
+public:
+	/**
+	* Called on the worker thread with a tightly packed frame, or null for a marker.  Tag and PaintTime are whatever
+	* was submitted with it; markers have a PaintTime of 0.
+	*/
+	typedef TFunction<void(const uint8* Frame, int32 Tag, double PaintTime)> FPresentFunction;
+
+	FXboxFrontPanelPresentWorker(uint32 InFrameSize, int32 NumFrames, FPresentFunction InPresent);
+	virtual ~FXboxFrontPanelPresentWorker();
+
+	/**
+	* Take a free buffer to fill.  Render thread only.
+	*
+	* @return		Buffer of the frame size, or null if every buffer is queued or being presented.
+	*/
+	uint8* AcquireFrame();
+
+	/**
+	* Queue a buffer returned by AcquireFrame for presentation.  Render thread only.
+	*
+	* @param PaintTime	When the frame's contents were painted, for latency tracking.
+	*/
+	void SubmitFrame(uint8* Frame, int32 Tag, double PaintTime);
+
+	/**
+	* Queue a marker without a frame behind the frames already submitted, such as a clear or a change of screen.
+	* Render thread only.  Unlike frames, a marker is still delivered when the worker is destroyed before getting to it.
+	*/
+	void SubmitMarker(int32 Tag);
+
+	uint32 GetFrameSize() const { return FrameSize; }
+
+public:
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	uint32 FrameSize;
+	FPresentFunction Present;
+
+	TArray<uint8*> Frames;
+	struct FPendingFrame
+	{
+		// Null for a marker
+		uint8* Frame;
+		int32 Tag;
+		double PaintTime;
+	};
+
+	TQueue<FPendingFrame, EQueueMode::Spsc> PendingFrames;
+	TQueue<uint8*, EQueueMode::Spsc> FreeFrames;
+
+	FEvent* FrameReadyEvent;
+	FThreadSafeBool bStopping;
+	FRunnableThread* Thread;
+};
@@ -0,0 +1,292 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelReplayDevice.h"
+#include "XboxFrontPanelAnimation.h"
+#include "XboxFrontPanelCapture.h"
+#include "XboxFrontPanelModulePrivate.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+
+// Mismatches past this many are counted but not logged individually
+static const uint32 MaxLoggedMismatches = 10;
+
+// Captured frames tried past the expected one before a present is counted as differing
+static const int32 ReplayResyncWindow = 8;
+
+// Seconds without a present after which button changes waiting on a frame are released anyway
+static const double ReplayStallTimeout = 1.0;
+
+TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> FXboxFrontPanelReplayDevice::Create(const FString& Filename)
+{
+	TSharedPtr<FXboxFrontPanelReplayDevice, ESPMode::ThreadSafe> Device = MakeShareable(new FXboxFrontPanelReplayDevice(Filename));
+	if (!FFileHelper::LoadFileToArray(Device->Capture, *Filename))
+	{
+		UE_LOG(LogXboxFrontPanel, Warning, TEXT("Cannot read front panel capture %s."), *Filename);
+		return nullptr;
+	}
+
+	if (!Device->Load())
+	{
+		UE_LOG(LogXboxFrontPanel, Warning, TEXT("%s is not a valid front panel capture."), *Filename);
+		return nullptr;
+	}
+
+	UE_LOG(LogXboxFrontPanel, Log, TEXT("Replaying front panel capture %s: %d frames, %d button changes."), *Filename, Device->Frames.Num(), Device->ButtonRecords.Num());
+	return Device;
+}
+
+FXboxFrontPanelReplayDevice::FXboxFrontPanelReplayDevice(const FString& InFilename)
+	: Filename(InFilename)
+	, Width(0)
+	, Height(0)
+	, Format(EXboxFrontPanelScreenFormat::R8)
+	, RowBytes(0)
+	, StartTime(FPlatformTime::Seconds())
+	, NextFrame(0)
+	, bLastFrameMismatched(false)
+	, LastPresentTime(StartTime)
+	, MatchedFrames(0)
+	, MismatchedFrames(0)
+	, SkippedFrames(0)
+	, ExtraFrames(0)
+	, NextButtonRecord(0)
+	, ButtonStates(EXboxFrontPanelButtons::None)
+	, LightStates(EXboxFrontPanelLights::None)
+{
+
+}
+
+FXboxFrontPanelReplayDevice::~FXboxFrontPanelReplayDevice()
+{
+	LogResult();
+}
+
+bool FXboxFrontPanelReplayDevice::Load()
+{
+	if (Capture.Num() < FXboxFrontPanelCaptureHeader::SerializedSize)
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Capture);
+
+	FXboxFrontPanelCaptureHeader Header;
+	Reader << Header;
+	if (Header.Magic != XboxFrontPanelCapture::Magic || Header.Version < 1 || Header.Version > XboxFrontPanelCapture::Version ||
+		Header.Format > static_cast<uint32>(EXboxFrontPanelScreenFormat::R1Dithered))
+	{
+		return false;
+	}
+
+	Width = Header.Width;
+	Height = Header.Height;
+	Format = static_cast<EXboxFrontPanelScreenFormat>(Header.Format);
+	RowBytes = Width > 0 ? FXboxFrontPanelLuminance::GetRowBytes(Format, Width) : 0;
+	if (RowBytes != Header.RowBytes)
+	{
+		return false;
+	}
+
+	// Records are indexed up front; frames are decoded one at a time as presents are compared against them
+	while (!Reader.AtEnd())
+	{
+		// Both record types continue with a uint32, a frame's size or the buttons
+		uint8 Type = 0;
+		double Time = 0.0;
+		uint32 Value = 0;
+		Reader << Type << Time << Value;
+
+		// Version 1 button records follow the frames presented before them, with no count of their own
+		uint32 FrameIndex = Frames.Num();
+		if (Type == static_cast<uint8>(EXboxFrontPanelCaptureRecord::Buttons) && Header.Version >= 2)
+		{
+			Reader << FrameIndex;
+		}
+
+		if (Reader.IsError() || (Type == static_cast<uint8>(EXboxFrontPanelCaptureRecord::Frame) && Reader.Tell() + Value > Capture.Num()))
+		{
+			// A capture cut short, by a crash for example, keeps every record before the damage
+			UE_LOG(LogXboxFrontPanel, Warning, TEXT("Front panel capture %s is truncated; replaying what is complete."), *Filename);
+			break;
+		}
+
+		if (Type == static_cast<uint8>(EXboxFrontPanelCaptureRecord::Frame))
+		{
+			if (RowBytes == 0)
+			{
+				return false;
+			}
+
+			FFrameRecord& Frame = Frames.AddDefaulted_GetRef();
+			Frame.Time = Time;
+			Frame.Offset = Reader.Tell();
+			Frame.Size = Value;
+			Reader.Seek(Frame.Offset + Frame.Size);
+		}
+		else if (Type == static_cast<uint8>(EXboxFrontPanelCaptureRecord::Buttons))
+		{
+			FButtonRecord& Record = ButtonRecords.AddDefaulted_GetRef();
+			Record.Buttons = static_cast<EXboxFrontPanelButtons>(Value) & EXboxFrontPanelButtons::All;
+			Record.FrameIndex = static_cast<int32>(FMath::Min<uint32>(FrameIndex, MAX_int32));
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	ExpectedFrame.SetNumZeroed(RowBytes * Height);
+	CandidateFrame.SetNumZeroed(RowBytes * Height);
+	LookaheadFrame.SetNumZeroed(RowBytes * Height);
+	return true;
+}
+
+void FXboxFrontPanelReplayDevice::LogResult() const
+{
+	const uint32 Compared = MatchedFrames + MismatchedFrames;
+	UE_LOG(LogXboxFrontPanel, Display, TEXT("Front panel replay of %s: %u of %u compared frames matched, %u differed, %u captured frames skipped, %d not reached, %u extra presents."),
+		*Filename, MatchedFrames, Compared, MismatchedFrames, SkippedFrames, Frames.Num() - NextFrame, ExtraFrames);
+}
+
+bool FXboxFrontPanelReplayDevice::GetScreenInfo(uint32& OutWidth, uint32& OutHeight, EXboxFrontPanelScreenFormat& OutFormat)
+{
+	OutWidth = Width;
+	OutHeight = Height;
+	OutFormat = Format;
+	return Width > 0 && Height > 0;
+}
+
+void FXboxFrontPanelReplayDevice::DecodeCapturedFrame(int32 Index, TArray<uint8>& Frame) const
+{
+	const FFrameRecord& Record = Frames[Index];
+	if (Record.Size > 0 && !FXboxFrontPanelAnimationDecoder::DecodeFrame(Capture.GetData() + Record.Offset, Record.Size, Frame.GetData(), RowBytes, RowBytes, Height))
+	{
+		UE_LOG(LogXboxFrontPanel, Warning, TEXT("Front panel capture %s is corrupt at frame %d; comparing against a partial frame."), *Filename, Index);
+	}
+}
+
+bool FXboxFrontPanelReplayDevice::PresentBuffer(const uint8* Data, uint32 Size)
+{
+	if (Size != RowBytes * Height)
+	{
+		UE_LOG(LogXboxFrontPanel, Warning, TEXT("Replayed front panel PresentBuffer given %u bytes, expected %u."), Size, RowBytes * Height);
+		return false;
+	}
+
+	FScopeLock ScopeLock(&FrameLock);
+	LastPresentTime = FPlatformTime::Seconds();
+
+	// Showing the frame the last mismatch was compared against again means that mismatch was a present the capture
+	// does not have
+	if (bLastFrameMismatched && FMemory::Memcmp(Data, ExpectedFrame.GetData(), Size) == 0)
+	{
+		--MismatchedFrames;
+		++MatchedFrames;
+		++ExtraFrames;
+		bLastFrameMismatched = false;
+		return true;
+	}
+
+	if (NextFrame >= Frames.Num())
+	{
+		++ExtraFrames;
+		return true;
+	}
+
+	CandidateFrame = ExpectedFrame;
+	DecodeCapturedFrame(NextFrame, CandidateFrame);
+
+	// Otherwise look a little further into the capture, for frames the replay never presented
+	int32 MatchIndex = INDEX_NONE;
+	if (FMemory::Memcmp(Data, CandidateFrame.GetData(), Size) == 0)
+	{
+		MatchIndex = NextFrame;
+	}
+	else
+	{
+		LookaheadFrame = CandidateFrame;
+		const int32 LastIndex = FMath::Min(NextFrame + ReplayResyncWindow, Frames.Num() - 1);
+		for (int32 Index = NextFrame + 1; Index <= LastIndex; ++Index)
+		{
+			DecodeCapturedFrame(Index, LookaheadFrame);
+			if (FMemory::Memcmp(Data, LookaheadFrame.GetData(), Size) == 0)
+			{
+				Exchange(CandidateFrame, LookaheadFrame);
+				MatchIndex = Index;
+				break;
+			}
+		}
+	}
+
+	if (MatchIndex != INDEX_NONE)
+	{
+		++MatchedFrames;
+		SkippedFrames += MatchIndex - NextFrame;
+		NextFrame = MatchIndex + 1;
+		bLastFrameMismatched = false;
+	}
+	else
+	{
+		// Compared against the frame at this point of the capture, which the next present resyncs from
+		if (MismatchedFrames < MaxLoggedMismatches)
+		{
+			uint32 FirstRow = 0;
+			while (FMemory::Memcmp(Data + FirstRow * RowBytes, CandidateFrame.GetData() + FirstRow * RowBytes, RowBytes) == 0)
+			{
+				++FirstRow;
+			}
+			UE_LOG(LogXboxFrontPanel, Warning, TEXT("Front panel replay frame %d differs from the capture, first at row %u (captured at %.3fs, presented at %.3fs)."),
+				NextFrame, FirstRow, Frames[NextFrame].Time, LastPresentTime - StartTime);
+		}
+		++MismatchedFrames;
+		++NextFrame;
+		bLastFrameMismatched = true;
+	}
+	Exchange(ExpectedFrame, CandidateFrame);
+
+	if (NextFrame == Frames.Num())
+	{
+		LogResult();
+	}
+	return true;
+}
+
+bool FXboxFrontPanelReplayDevice::GetButtonStates(EXboxFrontPanelButtons& OutButtons)
+{
+	int32 FramesReached;
+	double LastPresent;
+	{
+		FScopeLock ScopeLock(&FrameLock);
+		FramesReached = NextFrame;
+		LastPresent = LastPresentTime;
+	}
+	const bool bStalled = FPlatformTime::Seconds() - LastPresent >= ReplayStallTimeout;
+
+	// One change per sample, so a press and release captured between the same two frames are both seen
+	FScopeLock ScopeLock(&ButtonLock);
+	if (NextButtonRecord < ButtonRecords.Num() && (ButtonRecords[NextButtonRecord].FrameIndex <= FramesReached || bStalled))
+	{
+		ButtonStates = ButtonRecords[NextButtonRecord].Buttons;
+		++NextButtonRecord;
+	}
+
+	OutButtons = ButtonStates;
+	return true;
+}
+
+bool FXboxFrontPanelReplayDevice::GetLightStates(EXboxFrontPanelLights& OutLights)
+{
+	OutLights = LightStates;
+	return true;
+}
+
+bool FXboxFrontPanelReplayDevice::SetLightStates(EXboxFrontPanelLights Lights)
+{
+	LightStates = Lights & EXboxFrontPanelLights::All;
+	return true;
+}
@@ -0,0 +1,104 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "XboxFrontPanelDevice.h"
+#include "HAL/CriticalSection.h"
+
+/**
+* Plays a capture written by FXboxFrontPanelCaptureDevice back through the module.  The screen has the captured size
+* and format, so a replay runs anywhere, with or without a panel.
+*
+* Replay is paced by presents, not by the clock.  Each button change is reported once the replay has reached the
+* captured frame it followed, one change per GetButtonStates, so GenerateButtonEvents sees the recorded input between
+* the same frames whatever the frame rate or startup time.  Each present is compared against the next captured frame.
+* When it differs, the next few captured frames are tried too, so a capture frame the replay never presented is
+* counted as skipped, and a present that matches the frame before is counted as extra, rather than every later frame
+* failing.
+*
+* What remains nondeterministic: the input engine still times repeats from FPlatformTime, so held buttons can repeat
+* a different number of times; anything the title drives from the clock, such as UMG animations, paints differently
+* at a different frame rate; and a button change whose frame is never reached, because the replay stopped presenting
+* or diverged, is released by the clock after ReplayStallTimeout without a present so that replay cannot stall.
+*
+* Selected at startup with -XboxFrontPanelReplay=<file>, in place of any real or simulated panel.  The comparison is
+* logged once the last captured frame has been compared, and again at shutdown.
+*/
+class FXboxFrontPanelReplayDevice :
+	public IXboxFrontPanelDevice
+{
+public:
+	/** @return		A device replaying Filename, or null if it is missing or not a valid capture. */
+	static TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> Create(const FString& Filename);
+
+	virtual ~FXboxFrontPanelReplayDevice();
+
+public:
+	virtual bool GetScreenInfo(uint32& OutWidth, uint32& OutHeight, EXboxFrontPanelScreenFormat& OutFormat) override;
+	virtual bool PresentBuffer(const uint8* Data, uint32 Size) override;
+	virtual bool GetButtonStates(EXboxFrontPanelButtons& OutButtons) override;
+	virtual bool GetLightStates(EXboxFrontPanelLights& OutLights) override;
+	virtual bool SetLightStates(EXboxFrontPanelLights Lights) override;
+	virtual const TCHAR* GetName() const override { return TEXT("Replay"); }
+
+private:
+	struct FFrameRecord
+	{
+		double Time;
+		int64 Offset;
+		uint32 Size;
+	};
+
+	struct FButtonRecord
+	{
+		EXboxFrontPanelButtons Buttons;
+
+		// Captured frames presented before the change
+		int32 FrameIndex;
+	};
+
+	explicit FXboxFrontPanelReplayDevice(const FString& InFilename);
+
+	bool Load();
+	void LogResult() const;
+
+	/** Apply captured frame Index on top of Frame, which holds the one before it.  FrameLock must be held. */
+	void DecodeCapturedFrame(int32 Index, TArray<uint8>& Frame) const;
+
+	FString Filename;
+	TArray<uint8> Capture;
+
+	uint32 Width;
+	uint32 Height;
+	EXboxFrontPanelScreenFormat Format;
+	uint32 RowBytes;
+
+	TArray<FFrameRecord> Frames;
+	TArray<FButtonRecord> ButtonRecords;
+
+	// Only used to report when mismatching frames were presented
+	double StartTime;
+
+	// Presents and button samples arrive on different threads, so each side has its own lock
+	FCriticalSection FrameLock;
+
+	// Contents of captured frame NextFrame - 1, the last one compared, and scratch for looking ahead of it
+	TArray<uint8> ExpectedFrame;
+	TArray<uint8> CandidateFrame;
+	TArray<uint8> LookaheadFrame;
+	int32 NextFrame;
+	bool bLastFrameMismatched;
+	double LastPresentTime;
+	uint32 MatchedFrames;
+	uint32 MismatchedFrames;
+	uint32 SkippedFrames;
+	uint32 ExtraFrames;
+
+	FCriticalSection ButtonLock;
+	int32 NextButtonRecord;
+	EXboxFrontPanelButtons ButtonStates;
+
+	EXboxFrontPanelLights LightStates;
+};
@@ -0,0 +1,89 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelSharedMemoryDevice.h"
+#include "XboxFrontPanelModulePrivate.h"
+
+TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> FXboxFrontPanelSharedMemoryDevice::Create(TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> Inner, const FString& Name)
+{
+	check(Inner.IsValid());
+
+	// A panel without a usable screen still has buttons and lights worth sharing
+	uint32 Width = 0;
+	uint32 Height = 0;
+	EXboxFrontPanelScreenFormat Format = EXboxFrontPanelScreenFormat::R8;
+	if (!Inner->GetScreenInfo(Width, Height, Format))
+	{
+		Width = 0;
+		Height = 0;
+	}
+
+	TUniquePtr<FXboxFrontPanelSharedMemoryRegion> Region = FXboxFrontPanelSharedMemoryRegion::Create(Name, Width, Height, Format);
+	if (!Region.IsValid())
+	{
+		return nullptr;
+	}
+
+	EXboxFrontPanelLights Lights;
+	if (Inner->GetLightStates(Lights))
+	{
+		Region->PublishLights(Lights & EXboxFrontPanelLights::All);
+	}
+
+	UE_LOG(LogXboxFrontPanel, Log, TEXT("Sharing the Xbox Front Panel as %s.  Run -run=XboxFrontPanelViewer -Name=%s to view it."), *Name, *Name);
+	return MakeShareable(new FXboxFrontPanelSharedMemoryDevice(Inner, MoveTemp(Region)));
+}
+
+FXboxFrontPanelSharedMemoryDevice::FXboxFrontPanelSharedMemoryDevice(TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> InInner, TUniquePtr<FXboxFrontPanelSharedMemoryRegion> InRegion)
+	: Inner(InInner)
+	, Region(MoveTemp(InRegion))
+{
+
+}
+
+bool FXboxFrontPanelSharedMemoryDevice::GetScreenInfo(uint32& OutWidth, uint32& OutHeight, EXboxFrontPanelScreenFormat& OutFormat)
+{
+	return Inner->GetScreenInfo(OutWidth, OutHeight, OutFormat);
+}
+
+bool FXboxFrontPanelSharedMemoryDevice::PresentBuffer(const uint8* Data, uint32 Size)
+{
+	if (!Inner->PresentBuffer(Data, Size))
+	{
+		return false;
+	}
+
+	if (Size == Region->GetFrameSize())
+	{
+		Region->PublishFrame(Data);
+	}
+	return true;
+}
+
+bool FXboxFrontPanelSharedMemoryDevice::GetButtonStates(EXboxFrontPanelButtons& OutButtons)
+{
+	if (!Inner->GetButtonStates(OutButtons))
+	{
+		return false;
+	}
+
+	OutButtons |= Region->GetInjectedButtons();
+	return true;
+}
+
+bool FXboxFrontPanelSharedMemoryDevice::GetLightStates(EXboxFrontPanelLights& OutLights)
+{
+	return Inner->GetLightStates(OutLights);
+}
+
+bool FXboxFrontPanelSharedMemoryDevice::SetLightStates(EXboxFrontPanelLights Lights)
+{
+	if (!Inner->SetLightStates(Lights))
+	{
+		return false;
+	}
+
+	Region->PublishLights(Lights);
+	return true;
+}
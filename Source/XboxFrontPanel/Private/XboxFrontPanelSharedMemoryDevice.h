@@ -0,0 +1,39 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "XboxFrontPanelDevice.h"
+#include "XboxFrontPanelSharedMemoryRegion.h"
+
+/**
+* Wraps the device the module drives and publishes every presented frame and light change to a named shared memory
+* region (see XboxFrontPanelSharedMemory.h), where a viewer on the same machine can watch the panel and hold buttons
+* down on it.  Publishing is a copy into a ring slot and never waits on the viewer, so it can stay on for soak and
+* performance runs.
+*
+* Selected at startup with -XboxFrontPanelShare[=<Name>].  Without a panel, the simulated panel is shared.
+*/
+class FXboxFrontPanelSharedMemoryDevice :
+	public IXboxFrontPanelDevice
+{
+public:
+	/** @return		A device sharing Inner, or null if the region cannot be created. */
+	static TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> Create(TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> Inner, const FString& Name);
+
+public:
+	virtual bool GetScreenInfo(uint32& OutWidth, uint32& OutHeight, EXboxFrontPanelScreenFormat& OutFormat) override;
+	virtual bool PresentBuffer(const uint8* Data, uint32 Size) override;
+	virtual bool GetButtonStates(EXboxFrontPanelButtons& OutButtons) override;
+	virtual bool GetLightStates(EXboxFrontPanelLights& OutLights) override;
+	virtual bool SetLightStates(EXboxFrontPanelLights Lights) override;
+	virtual const TCHAR* GetName() const override { return Inner->GetName(); }
+	virtual IXboxFrontPanelDevice* GetInnerDevice() override { return Inner.Get(); }
+
+private:
+	FXboxFrontPanelSharedMemoryDevice(TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> InInner, TUniquePtr<FXboxFrontPanelSharedMemoryRegion> InRegion);
+
+	TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> Inner;
+	TUniquePtr<FXboxFrontPanelSharedMemoryRegion> Region;
+};
@@ -0,0 +1,229 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelSharedMemoryRegion.h"
+#include "XboxFrontPanelModulePrivate.h"
+
+#include "HAL/PlatformAtomics.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+
+TUniquePtr<FXboxFrontPanelSharedMemoryRegion> FXboxFrontPanelSharedMemoryRegion::Create(const FString& Name, uint32 Width, uint32 Height, EXboxFrontPanelScreenFormat Format)
+{
+	using namespace XboxFrontPanelSharedMemory;
+
+	const uint32 RowBytes = FXboxFrontPanelLuminance::GetRowBytes(Format, Width);
+	const uint32 FrameSize = RowBytes * Height;
+	const uint32 Slots = FrameSize > 0 ? SlotCount : 0;
+	const uint32 SlotStride = Align(SlotHeaderSize + FrameSize, SlotAlignment);
+
+	FPlatformMemory::FSharedMemoryRegion* Region = FPlatformMemory::MapNamedSharedMemoryRegion(Name, true,
+		FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write, HeaderSize + Slots * SlotStride);
+	if (Region == nullptr)
+	{
+		UE_LOG(LogXboxFrontPanel, Warning, TEXT("Cannot create front panel shared memory %s."), *Name);
+		return nullptr;
+	}
+
+	// Viewers still attached to a region left by an earlier run see it go invalid before it is laid out again
+	FXboxFrontPanelSharedMemoryHeader* Header = static_cast<FXboxFrontPanelSharedMemoryHeader*>(Region->GetAddress());
+	FPlatformAtomics::InterlockedExchange(&Header->Magic, 0);
+
+	FMemory::Memzero(static_cast<uint8*>(Region->GetAddress()) + sizeof(Header->Magic), Region->GetSize() - sizeof(Header->Magic));
+	Header->Version = Version;
+	Header->Width = Width;
+	Header->Height = Height;
+	Header->Format = static_cast<uint32>(Format);
+	Header->RowBytes = RowBytes;
+	Header->SlotCount = Slots;
+	Header->SlotStride = SlotStride;
+
+	FPlatformMisc::MemoryBarrier();
+	FPlatformAtomics::InterlockedExchange(&Header->Magic, static_cast<int32>(Magic));
+
+	return TUniquePtr<FXboxFrontPanelSharedMemoryRegion>(new FXboxFrontPanelSharedMemoryRegion(Region, true));
+}
+
+TUniquePtr<FXboxFrontPanelSharedMemoryRegion> FXboxFrontPanelSharedMemoryRegion::Open(const FString& Name)
+{
+	using namespace XboxFrontPanelSharedMemory;
+
+	const uint32 AccessMode = FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write;
+
+	// The header says how much to map
+	FPlatformMemory::FSharedMemoryRegion* HeaderRegion = FPlatformMemory::MapNamedSharedMemoryRegion(Name, false, AccessMode, HeaderSize);
+	if (HeaderRegion == nullptr)
+	{
+		return nullptr;
+	}
+
+	const FXboxFrontPanelSharedMemoryHeader* Header = static_cast<const FXboxFrontPanelSharedMemoryHeader*>(HeaderRegion->GetAddress());
+	const bool bValid = static_cast<uint32>(FPlatformAtomics::AtomicRead(&Header->Magic)) == Magic && Header->Version == Version;
+	FPlatformMisc::MemoryBarrier();
+	const SIZE_T Size = HeaderSize + static_cast<SIZE_T>(Header->SlotCount) * Header->SlotStride;
+	FPlatformMemory::UnmapNamedSharedMemoryRegion(HeaderRegion);
+
+	if (!bValid)
+	{
+		return nullptr;
+	}
+
+	FPlatformMemory::FSharedMemoryRegion* Region = FPlatformMemory::MapNamedSharedMemoryRegion(Name, false, AccessMode, Size);
+	if (Region == nullptr)
+	{
+		return nullptr;
+	}
+
+	TUniquePtr<FXboxFrontPanelSharedMemoryRegion> Result(new FXboxFrontPanelSharedMemoryRegion(Region, false));
+	if (!Result->IsValid())
+	{
+		// Laid out again between the two mappings
+		return nullptr;
+	}
+	return Result;
+}
+
+FXboxFrontPanelSharedMemoryRegion::FXboxFrontPanelSharedMemoryRegion(FPlatformMemory::FSharedMemoryRegion* InRegion, bool bInOwner)
+	: Region(InRegion)
+	, Header(static_cast<FXboxFrontPanelSharedMemoryHeader*>(InRegion->GetAddress()))
+	, bOwner(bInOwner)
+	, MappedWidth(Header->Width)
+	, MappedHeight(Header->Height)
+	, MappedFormat(static_cast<EXboxFrontPanelScreenFormat>(Header->Format))
+	, MappedRowBytes(Header->RowBytes)
+	, MappedSlotCount(Header->SlotCount)
+	, MappedSlotStride(Header->SlotStride)
+	, MappedFrameSize(MappedRowBytes * MappedHeight)
+	, LastViewerHeartbeat(0)
+	, LastViewerHeartbeatTime(0.0)
+{
+	// A header read while the title was laying it out again, or one describing slots past the end of the mapping, is
+	// never addressed.  IsValid reports the former once the new layout is complete.
+	const bool bFormatValid = Header->Format <= static_cast<uint32>(EXboxFrontPanelScreenFormat::R1Dithered) &&
+		MappedRowBytes == FXboxFrontPanelLuminance::GetRowBytes(MappedFormat, MappedWidth);
+	if (!bFormatValid ||
+		XboxFrontPanelSharedMemory::HeaderSize + static_cast<SIZE_T>(MappedSlotCount) * MappedSlotStride > Region->GetSize() ||
+		(MappedSlotCount > 0 && XboxFrontPanelSharedMemory::SlotHeaderSize + MappedFrameSize > MappedSlotStride))
+	{
+		MappedSlotCount = 0;
+	}
+}
+
+FXboxFrontPanelSharedMemoryRegion::~FXboxFrontPanelSharedMemoryRegion()
+{
+	if (bOwner)
+	{
+		// A viewer that outlives the title sees the region go invalid rather than a frozen screen
+		FPlatformAtomics::InterlockedExchange(&Header->Magic, 0);
+	}
+	else
+	{
+		FPlatformAtomics::InterlockedExchange(&Header->InjectedButtons, 0);
+	}
+	FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+}
+
+uint8* FXboxFrontPanelSharedMemoryRegion::GetSlot(int64 FrameIndex) const
+{
+	return static_cast<uint8*>(Region->GetAddress()) + XboxFrontPanelSharedMemory::HeaderSize + (FrameIndex % MappedSlotCount) * MappedSlotStride;
+}
+
+void FXboxFrontPanelSharedMemoryRegion::PublishFrame(const uint8* Data)
+{
+	if (MappedSlotCount == 0)
+	{
+		return;
+	}
+
+	// Only this side writes FrameCount, so a plain read is current
+	const int64 FrameIndex = Header->FrameCount;
+	uint8* Slot = GetSlot(FrameIndex);
+	FXboxFrontPanelSharedMemorySlot* SlotHeader = reinterpret_cast<FXboxFrontPanelSharedMemorySlot*>(Slot);
+
+	FPlatformAtomics::InterlockedExchange(&SlotHeader->Sequence, FrameIndex * 2 + 1);
+	FMemory::Memcpy(Slot + XboxFrontPanelSharedMemory::SlotHeaderSize, Data, MappedFrameSize);
+	FPlatformAtomics::InterlockedExchange(&SlotHeader->Sequence, FrameIndex * 2 + 2);
+	FPlatformAtomics::InterlockedExchange(&Header->FrameCount, FrameIndex + 1);
+}
+
+void FXboxFrontPanelSharedMemoryRegion::PublishLights(EXboxFrontPanelLights Lights)
+{
+	FPlatformAtomics::InterlockedExchange(&Header->Lights, static_cast<int32>(Lights));
+}
+
+EXboxFrontPanelButtons FXboxFrontPanelSharedMemoryRegion::GetInjectedButtons()
+{
+	const double CurrentTime = FPlatformTime::Seconds();
+	const int32 Heartbeat = FPlatformAtomics::AtomicRead(&Header->ViewerHeartbeat);
+	if (Heartbeat != LastViewerHeartbeat)
+	{
+		LastViewerHeartbeat = Heartbeat;
+		LastViewerHeartbeatTime = CurrentTime;
+	}
+
+	if (CurrentTime - LastViewerHeartbeatTime > XboxFrontPanelSharedMemory::ViewerTimeout)
+	{
+		return EXboxFrontPanelButtons::None;
+	}
+	return static_cast<EXboxFrontPanelButtons>(FPlatformAtomics::AtomicRead(&Header->InjectedButtons)) & EXboxFrontPanelButtons::All;
+}
+
+bool FXboxFrontPanelSharedMemoryRegion::IsValid() const
+{
+	if (static_cast<uint32>(FPlatformAtomics::AtomicRead(&Header->Magic)) != XboxFrontPanelSharedMemory::Magic)
+	{
+		return false;
+	}
+
+	// A region laid out again for another screen still carries Magic once the new layout is complete
+	FPlatformMisc::MemoryBarrier();
+	return Header->Width == MappedWidth && Header->Height == MappedHeight && Header->Format == static_cast<uint32>(MappedFormat) &&
+		Header->RowBytes == MappedRowBytes && Header->SlotCount == MappedSlotCount && Header->SlotStride == MappedSlotStride;
+}
+
+bool FXboxFrontPanelSharedMemoryRegion::ReadFrame(int64& InOutFrameCount, TArray<uint8>& OutFrame) const
+{
+	if (MappedSlotCount == 0)
+	{
+		return false;
+	}
+
+	const int64 FrameCount = FPlatformAtomics::AtomicRead(&Header->FrameCount);
+	if (FrameCount == InOutFrameCount || FrameCount == 0)
+	{
+		return false;
+	}
+
+	const uint8* Slot = GetSlot(FrameCount - 1);
+	const FXboxFrontPanelSharedMemorySlot* SlotHeader = reinterpret_cast<const FXboxFrontPanelSharedMemorySlot*>(Slot);
+	const int64 Complete = FrameCount * 2;
+	if (FPlatformAtomics::AtomicRead(&SlotHeader->Sequence) != Complete)
+	{
+		return false;
+	}
+
+	OutFrame.SetNumUninitialized(MappedFrameSize);
+	FMemory::Memcpy(OutFrame.GetData(), Slot + XboxFrontPanelSharedMemory::SlotHeaderSize, MappedFrameSize);
+
+	// The title lapped the ring, or laid the region out again, while we were copying
+	FPlatformMisc::MemoryBarrier();
+	if (FPlatformAtomics::AtomicRead(&SlotHeader->Sequence) != Complete || !IsValid())
+	{
+		return false;
+	}
+
+	InOutFrameCount = FrameCount;
+	return true;
+}
+
+EXboxFrontPanelLights FXboxFrontPanelSharedMemoryRegion::GetLights() const
+{
+	return static_cast<EXboxFrontPanelLights>(FPlatformAtomics::AtomicRead(&Header->Lights)) & EXboxFrontPanelLights::All;
+}
+
+void FXboxFrontPanelSharedMemoryRegion::InjectButtons(EXboxFrontPanelButtons Buttons)
+{
+	FPlatformAtomics::InterlockedExchange(&Header->InjectedButtons, static_cast<int32>(Buttons & EXboxFrontPanelButtons::All));
+	FPlatformAtomics::InterlockedIncrement(&Header->ViewerHeartbeat);
+}
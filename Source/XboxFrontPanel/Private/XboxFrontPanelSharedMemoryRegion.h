@@ -0,0 +1,90 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformMemory.h"
+#include "XboxFrontPanelDevice.h"
+#include "XboxFrontPanelSharedMemory.h"
+
+/**
+* A mapping of the front panel shared memory region (see XboxFrontPanelSharedMemory.h), from either side.  The title
+* creates it and publishes frames and lights; the viewer opens it, reads them back and injects buttons.  Neither side
+* ever waits for the other.
+*/
+class FXboxFrontPanelSharedMemoryRegion
+{
+public:
+	/**
+	* Create the region, or take over one left behind by an earlier run, laid out for the given screen.  A panel
+	* without a screen has a region with no slots, which still carries lights and buttons.
+	*
+	* @return		The title's side of the region, or null if the platform cannot share memory by name.
+	*/
+	static TUniquePtr<FXboxFrontPanelSharedMemoryRegion> Create(const FString& Name, uint32 Width, uint32 Height, EXboxFrontPanelScreenFormat Format);
+
+	/** @return		The viewer's side of the region, or null if no title has created it. */
+	static TUniquePtr<FXboxFrontPanelSharedMemoryRegion> Open(const FString& Name);
+
+	~FXboxFrontPanelSharedMemoryRegion();
+
+	/** Layout as of when the region was mapped.  Unlike the header, these never change under the caller. */
+	uint32 GetWidth() const { return MappedWidth; }
+	uint32 GetHeight() const { return MappedHeight; }
+	EXboxFrontPanelScreenFormat GetFormat() const { return MappedFormat; }
+	uint32 GetRowBytes() const { return MappedRowBytes; }
+	uint32 GetFrameSize() const { return MappedFrameSize; }
+
+public:
+	/** Copy a frame into the next slot.  Called by one thread at a time, never blocks. */
+	void PublishFrame(const uint8* Data);
+
+	void PublishLights(EXboxFrontPanelLights Lights);
+
+	/**
+	* @return		Buttons the viewer holds down, or None once its heartbeat has stopped for ViewerTimeout.  Called by
+	*				one thread at a time.
+	*/
+	EXboxFrontPanelButtons GetInjectedButtons();
+
+public:
+	/** @return		False once the title has laid the region out again, after which it must be reopened. */
+	bool IsValid() const;
+
+	/**
+	* Copy out the newest frame if it is newer than InOutFrameCount.
+	*
+	* @param InOutFrameCount	Frames seen so far, updated to the copied frame.
+	* @return					True if OutFrame holds a new, complete frame of GetFrameSize bytes.
+	*/
+	bool ReadFrame(int64& InOutFrameCount, TArray<uint8>& OutFrame) const;
+
+	EXboxFrontPanelLights GetLights() const;
+
+	/** Hold Buttons down on the title's panel.  Call at least every ViewerTimeout seconds to keep holding them. */
+	void InjectButtons(EXboxFrontPanelButtons Buttons);
+
+private:
+	FXboxFrontPanelSharedMemoryRegion(FPlatformMemory::FSharedMemoryRegion* InRegion, bool bInOwner);
+
+	uint8* GetSlot(int64 FrameIndex) const;
+
+	FPlatformMemory::FSharedMemoryRegion* Region;
+	FXboxFrontPanelSharedMemoryHeader* Header;
+	bool bOwner;
+
+	// Layout the region was mapped with.  The title can lay the header out again at any time, so only these are used
+	// to address the mapping, and IsValid compares the header against them.
+	uint32 MappedWidth;
+	uint32 MappedHeight;
+	EXboxFrontPanelScreenFormat MappedFormat;
+	uint32 MappedRowBytes;
+	uint32 MappedSlotCount;
+	uint32 MappedSlotStride;
+	uint32 MappedFrameSize;
+
+	// Title side: the last heartbeat seen from the viewer, and when it changed
+	int32 LastViewerHeartbeat;
+	double LastViewerHeartbeatTime;
+};
@@ -0,0 +1,333 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelSimulatedDevice.h"
+#include "XboxFrontPanelModulePrivate.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+static TAutoConsoleVariable<int32> CVarSimWidth(
+	TEXT("XboxFrontPanel.Sim.Width"),
+	256,
+	TEXT("Screen width in pixels of the simulated front panel.  Read when the simulated device is created."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSimHeight(
+	TEXT("XboxFrontPanel.Sim.Height"),
+	64,
+	TEXT("Screen height in pixels of the simulated front panel.  Read when the simulated device is created."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSimBitsPerPixel(
+	TEXT("XboxFrontPanel.Sim.BitsPerPixel"),
+	8,
+	TEXT("Screen depth of the simulated front panel: 8, 4 or 1.  Read when the simulated device is created."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSimPresentLatency(
+	TEXT("XboxFrontPanel.Sim.PresentLatencyMs"),
+	0.0f,
+	TEXT("Milliseconds each simulated PresentBuffer call blocks for."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSimButtonLatency(
+	TEXT("XboxFrontPanel.Sim.ButtonLatencyMs"),
+	0.0f,
+	TEXT("Milliseconds each simulated GetButtonStates call blocks for."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSimLightLatency(
+	TEXT("XboxFrontPanel.Sim.LightLatencyMs"),
+	0.0f,
+	TEXT("Milliseconds each simulated GetLightStates or SetLightStates call blocks for."),
+	ECVF_Default);
+
+static void SimulateLatency(TAutoConsoleVariable<float>& LatencyMs)
+{
+	const float Milliseconds = LatencyMs.GetValueOnAnyThread();
+	if (Milliseconds > 0.0f)
+	{
+		FPlatformProcess::Sleep(Milliseconds / 1000.0f);
+	}
+}
+
+FXboxFrontPanelSimulatedDevice::FXboxFrontPanelSimulatedDevice(uint32 InWidth, uint32 InHeight, EXboxFrontPanelScreenFormat InFormat)
+	: Width(InWidth)
+	, Height(InHeight)
+	, Format(InFormat)
+	, PresentCount(0)
+	, ButtonStates(EXboxFrontPanelButtons::None)
+	, LightStates(EXboxFrontPanelLights::None)
+	, LightCommitCount(0)
+{
+
+}
+
+TSharedPtr<FXboxFrontPanelSimulatedDevice, ESPMode::ThreadSafe> FXboxFrontPanelSimulatedDevice::CreateFromConsoleVariables()
+{
+	EXboxFrontPanelScreenFormat SimFormat;
+	switch (CVarSimBitsPerPixel.GetValueOnGameThread())
+	{
+	case 1:
+		SimFormat = EXboxFrontPanelScreenFormat::R1Threshold;
+		break;
+	case 4:
+		SimFormat = EXboxFrontPanelScreenFormat::R4;
+		break;
+	default:
+		SimFormat = EXboxFrontPanelScreenFormat::R8;
+		break;
+	}
+
+	const uint32 SimWidth = FMath::Max(CVarSimWidth.GetValueOnGameThread(), 1);
+	const uint32 SimHeight = FMath::Max(CVarSimHeight.GetValueOnGameThread(), 1);
+	return MakeShared<FXboxFrontPanelSimulatedDevice, ESPMode::ThreadSafe>(SimWidth, SimHeight, SimFormat);
+}
+
+bool FXboxFrontPanelSimulatedDevice::GetScreenInfo(uint32& OutWidth, uint32& OutHeight, EXboxFrontPanelScreenFormat& OutFormat)
+{
+	OutWidth = Width;
+	OutHeight = Height;
+	OutFormat = Format;
+	return true;
+}
+
+bool FXboxFrontPanelSimulatedDevice::PresentBuffer(const uint8* Data, uint32 Size)
+{
+	SimulateLatency(CVarSimPresentLatency);
+
+	const uint32 ExpectedSize = FXboxFrontPanelLuminance::GetRowBytes(Format, Width) * Height;
+	if (Size != ExpectedSize)
+	{
+		UE_LOG(LogXboxFrontPanel, Warning, TEXT("Simulated front panel PresentBuffer given %u bytes, expected %u."), Size, ExpectedSize);
+		return false;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	Framebuffer.SetNumUninitialized(Size);
+	FMemory::Memcpy(Framebuffer.GetData(), Data, Size);
+	++PresentCount;
+	return true;
+}
+
+bool FXboxFrontPanelSimulatedDevice::GetButtonStates(EXboxFrontPanelButtons& OutButtons)
+{
+	SimulateLatency(CVarSimButtonLatency);
+
+	const double CurrentTime = FPlatformTime::Seconds();
+
+	FScopeLock ScopeLock(&Lock);
+	int32 FinishedSteps = 0;
+	while (FinishedSteps < ButtonScript.Num() && ButtonScript[FinishedSteps].EndTime <= CurrentTime)
+	{
+		++FinishedSteps;
+	}
+	ButtonScript.RemoveAt(0, FinishedSteps, false);
+
+	OutButtons = ButtonScript.Num() > 0 ? ButtonScript[0].Buttons : ButtonStates;
+	return true;
+}
+
+bool FXboxFrontPanelSimulatedDevice::GetLightStates(EXboxFrontPanelLights& OutLights)
+{
+	SimulateLatency(CVarSimLightLatency);
+
+	FScopeLock ScopeLock(&Lock);
+	OutLights = LightStates;
+	return true;
+}
+
+bool FXboxFrontPanelSimulatedDevice::SetLightStates(EXboxFrontPanelLights Lights)
+{
+	SimulateLatency(CVarSimLightLatency);
+
+	FScopeLock ScopeLock(&Lock);
+	LightStates = Lights & EXboxFrontPanelLights::All;
+	++LightCommitCount;
+	return true;
+}
+
+void FXboxFrontPanelSimulatedDevice::SetButtonStates(EXboxFrontPanelButtons Buttons)
+{
+	FScopeLock ScopeLock(&Lock);
+	ButtonStates = Buttons & EXboxFrontPanelButtons::All;
+}
+
+void FXboxFrontPanelSimulatedDevice::QueueButtonStep(EXboxFrontPanelButtons Buttons, double Duration)
+{
+	FScopeLock ScopeLock(&Lock);
+	const double StartTime = ButtonScript.Num() > 0 ? ButtonScript.Last().EndTime : FPlatformTime::Seconds();
+
+	FButtonStep& Step = ButtonScript.AddDefaulted_GetRef();
+	Step.Buttons = Buttons & EXboxFrontPanelButtons::All;
+	Step.EndTime = StartTime + FMath::Max(Duration, 0.0);
+}
+
+void FXboxFrontPanelSimulatedDevice::ClearButtonScript()
+{
+	FScopeLock ScopeLock(&Lock);
+	ButtonScript.Reset();
+}
+
+bool FXboxFrontPanelSimulatedDevice::IsButtonScriptPlaying() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return ButtonScript.Num() > 0;
+}
+
+uint32 FXboxFrontPanelSimulatedDevice::CopyFramebuffer(TArray<uint8>& OutData) const
+{
+	FScopeLock ScopeLock(&Lock);
+	OutData = Framebuffer;
+	return PresentCount;
+}
+
+bool FXboxFrontPanelSimulatedDevice::SaveFramebuffer(const FString& Filename) const
+{
+	TArray<uint8> Packed;
+	if (CopyFramebuffer(Packed) == 0)
+	{
+		return false;
+	}
+
+	const FString Header = FString::Printf(TEXT("P5\n%u %u\n255\n"), Width, Height);
+
+	TArray<uint8> Image;
+	Image.Reserve(Header.Len() + Width * Height);
+	for (TCHAR Character : Header)
+	{
+		Image.Add(static_cast<uint8>(Character));
+	}
+
+	const int32 PixelOffset = Image.AddUninitialized(Width * Height);
+	FXboxFrontPanelLuminance::UnpackR8(Format, Packed.GetData(), FXboxFrontPanelLuminance::GetRowBytes(Format, Width), Image.GetData() + PixelOffset, Width, Width, Height);
+
+	return FFileHelper::SaveArrayToFile(Image, *Filename);
+}
+
+uint32 FXboxFrontPanelSimulatedDevice::GetLightCommitCount() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return LightCommitCount;
+}
+
+static FXboxFrontPanelSimulatedDevice* GetSimulatedDevice(FOutputDevice& Ar)
+{
+	// Look through a capture or share of the simulated panel
+	IXboxFrontPanelDevice* Device = IXboxFrontPanelModule::Get().GetDevice();
+	while (Device != nullptr && !Device->IsSimulated())
+	{
+		Device = Device->GetInnerDevice();
+	}
+
+	if (Device == nullptr)
+	{
+		Ar.Logf(TEXT("The front panel is not simulated.  Start with XboxFrontPanel.Simulate=1 or -XboxFrontPanelSim."));
+		return nullptr;
+	}
+	return static_cast<FXboxFrontPanelSimulatedDevice*>(Device);
+}
+
+bool FXboxFrontPanelSimulatedDevice::ParseButtons(const FString& Text, EXboxFrontPanelButtons& OutButtons)
+{
+	static const TPair<const TCHAR*, EXboxFrontPanelButtons> ButtonNames[] =
+	{
+		{ TEXT("Button1"), EXboxFrontPanelButtons::Button1 },
+		{ TEXT("Button2"), EXboxFrontPanelButtons::Button2 },
+		{ TEXT("Button3"), EXboxFrontPanelButtons::Button3 },
+		{ TEXT("Button4"), EXboxFrontPanelButtons::Button4 },
+		{ TEXT("Button5"), EXboxFrontPanelButtons::Button5 },
+		{ TEXT("Left"), EXboxFrontPanelButtons::Left },
+		{ TEXT("Right"), EXboxFrontPanelButtons::Right },
+		{ TEXT("Up"), EXboxFrontPanelButtons::Up },
+		{ TEXT("Down"), EXboxFrontPanelButtons::Down },
+		{ TEXT("Select"), EXboxFrontPanelButtons::Select },
+		{ TEXT("None"), EXboxFrontPanelButtons::None },
+	};
+
+	TArray<FString> Names;
+	Text.ParseIntoArray(Names, TEXT("+"));
+
+	OutButtons = EXboxFrontPanelButtons::None;
+	for (const FString& Name : Names)
+	{
+		bool bFound = false;
+		for (const TPair<const TCHAR*, EXboxFrontPanelButtons>& ButtonName : ButtonNames)
+		{
+			if (Name == ButtonName.Key)
+			{
+				OutButtons |= ButtonName.Value;
+				bFound = true;
+				break;
+			}
+		}
+
+		if (!bFound)
+		{
+			return false;
+		}
+	}
+	return Names.Num() > 0;
+}
+
+static void SimulateButtonScript(const TArray<FString>& Args, FOutputDevice& Ar)
+{
+	FXboxFrontPanelSimulatedDevice* Device = GetSimulatedDevice(Ar);
+	if (Device == nullptr)
+	{
+		return;
+	}
+
+	// Arguments are Buttons[:Seconds] steps, so "Up:0.5 None:0.1 Select" holds Up, releases, then taps Select.
+	for (const FString& Arg : Args)
+	{
+		FString ButtonText = Arg;
+		FString DurationText;
+		Arg.Split(TEXT(":"), &ButtonText, &DurationText);
+
+		EXboxFrontPanelButtons Buttons;
+		if (!FXboxFrontPanelSimulatedDevice::ParseButtons(ButtonText, Buttons))
+		{
+			Ar.Logf(TEXT("Usage: XboxFrontPanel.Sim.Buttons Buttons[:Seconds] ...  where Buttons is None or names joined with +, from Button1-5, Left, Right, Up, Down, Select."));
+			return;
+		}
+
+		Device->QueueButtonStep(Buttons, DurationText.IsEmpty() ? 0.1 : FCString::Atod(*DurationText));
+	}
+}
+
+static void SaveSimulatedScreen(const TArray<FString>& Args, FOutputDevice& Ar)
+{
+	FXboxFrontPanelSimulatedDevice* Device = GetSimulatedDevice(Ar);
+	if (Device == nullptr)
+	{
+		return;
+	}
+
+	const FString Filename = Args.Num() > 0 ? Args[0] : FPaths::ProjectSavedDir() / TEXT("FrontPanel.pgm");
+	if (Device->SaveFramebuffer(Filename))
+	{
+		Ar.Logf(TEXT("Saved simulated front panel screen to %s"), *Filename);
+	}
+	else
+	{
+		Ar.Logf(TEXT("Could not save simulated front panel screen to %s"), *Filename);
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice SimulateButtonScriptCommand(
+	TEXT("XboxFrontPanel.Sim.Buttons"),
+	TEXT("Queue scripted input on the simulated front panel: Buttons[:Seconds] ..."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld*, FOutputDevice& Ar) { SimulateButtonScript(Args, Ar); }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice SaveSimulatedScreenCommand(
+	TEXT("XboxFrontPanel.Sim.SaveScreen"),
+	TEXT("Write the last frame presented to the simulated front panel to a PGM image: [Filename]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld*, FOutputDevice& Ar) { SaveSimulatedScreen(Args, Ar); }));
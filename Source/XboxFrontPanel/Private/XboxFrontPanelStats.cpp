@@ -0,0 +1,192 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelStats.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/ScopeLock.h"
+
+CSV_DEFINE_CATEGORY(XboxFrontPanel, true);
+
+DEFINE_STAT(STAT_XboxFrontPanel_DrawWindow);
+DEFINE_STAT(STAT_XboxFrontPanel_EnqueueReadback);
+DEFINE_STAT(STAT_XboxFrontPanel_MapStagingSurface);
+DEFINE_STAT(STAT_XboxFrontPanel_ConvertLuminance);
+DEFINE_STAT(STAT_XboxFrontPanel_PackCanvas);
+DEFINE_STAT(STAT_XboxFrontPanel_DecodeAnimation);
+DEFINE_STAT(STAT_XboxFrontPanel_PresentBuffer);
+DEFINE_STAT(STAT_XboxFrontPanel_GetButtonStates);
+DEFINE_STAT(STAT_XboxFrontPanel_GetLightStates);
+DEFINE_STAT(STAT_XboxFrontPanel_SetLightStates);
+DEFINE_STAT(STAT_XboxFrontPanel_PerfHud);
+
+FXboxFrontPanelSampleHistory::FXboxFrontPanelSampleHistory(int32 InMaxSamples)
+	: MaxSamples(InMaxSamples)
+	, NextIndex(0)
+	, TotalCount(0)
+{
+	check(MaxSamples > 0);
+}
+
+void FXboxFrontPanelSampleHistory::Add(float Sample)
+{
+	if (Samples.Num() < MaxSamples)
+	{
+		Samples.Add(Sample);
+	}
+	else
+	{
+		Samples[NextIndex] = Sample;
+	}
+	NextIndex = (NextIndex + 1) % MaxSamples;
+	++TotalCount;
+}
+
+void FXboxFrontPanelSampleHistory::Reset()
+{
+	Samples.Reset();
+	NextIndex = 0;
+	TotalCount = 0;
+}
+
+bool FXboxFrontPanelSampleHistory::Summarize(FXboxFrontPanelSampleSummary& OutSummary) const
+{
+	if (Samples.Num() == 0)
+	{
+		return false;
+	}
+
+	TArray<float> Sorted = Samples;
+	Sorted.Sort();
+
+	double Sum = 0.0;
+	for (float Sample : Sorted)
+	{
+		Sum += Sample;
+	}
+
+	OutSummary.Min = Sorted[0];
+	OutSummary.Avg = static_cast<float>(Sum / Sorted.Num());
+	OutSummary.P50 = Sorted[Sorted.Num() / 2];
+	OutSummary.P99 = Sorted[FMath::Min(Sorted.Num() - 1, (Sorted.Num() * 99) / 100)];
+	OutSummary.Max = Sorted.Last();
+	return true;
+}
+
+FXboxFrontPanelDumpCommand::FXboxFrontPanelDumpCommand(const TCHAR* Name, const TCHAR* Help, void (*Dump)(FOutputDevice&), void (*Reset)())
+	: Command(Name, Help, FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([Dump, Reset](const TArray<FString>& Args, UWorld*, FOutputDevice& Ar)
+		{
+			Dump(Ar);
+
+			if (Args.Num() > 0 && Args[0] == TEXT("Reset"))
+			{
+				Reset();
+			}
+		}))
+{
+}
+
+namespace XboxFrontPanelStats
+{
+	// Enough for several seconds of every per-frame stage at 60Hz, and cheap to sort when dumping.
+	static const int32 MaxSamples = 1024;
+
+	struct FStageSamples
+	{
+		FCriticalSection Lock;
+
+		// Microseconds
+		FXboxFrontPanelSampleHistory History{ MaxSamples };
+	};
+
+	static FStageSamples& GetSamples(EXboxFrontPanelStage Stage)
+	{
+		static FStageSamples Samples[static_cast<int32>(EXboxFrontPanelStage::Count)];
+		return Samples[static_cast<int32>(Stage)];
+	}
+}
+
+void FXboxFrontPanelStageHistory::Record(EXboxFrontPanelStage Stage, uint64 Cycles)
+{
+	XboxFrontPanelStats::FStageSamples& Samples = XboxFrontPanelStats::GetSamples(Stage);
+	const float Microseconds = static_cast<float>(Cycles * FPlatformTime::GetSecondsPerCycle64() * 1.0e6);
+
+	FScopeLock ScopeLock(&Samples.Lock);
+	Samples.History.Add(Microseconds);
+}
+
+void FXboxFrontPanelStageHistory::Dump(FOutputDevice& Ar)
+{
+	Ar.Logf(TEXT("Front panel stage times over the last %d samples (microseconds):"), XboxFrontPanelStats::MaxSamples);
+	Ar.Logf(TEXT("  %-20s %8s %8s %8s %8s %10s"), TEXT("Stage"), TEXT("Min"), TEXT("Avg"), TEXT("P99"), TEXT("Max"), TEXT("Count"));
+
+	for (int32 StageIndex = 0; StageIndex < static_cast<int32>(EXboxFrontPanelStage::Count); ++StageIndex)
+	{
+		const EXboxFrontPanelStage Stage = static_cast<EXboxFrontPanelStage>(StageIndex);
+		XboxFrontPanelStats::FStageSamples& Samples = XboxFrontPanelStats::GetSamples(Stage);
+
+		// Copied so that stages can keep recording while this one is sorted
+		FXboxFrontPanelSampleHistory History(XboxFrontPanelStats::MaxSamples);
+		{
+			FScopeLock ScopeLock(&Samples.Lock);
+			History = Samples.History;
+		}
+
+		FXboxFrontPanelSampleSummary Summary;
+		if (History.Summarize(Summary))
+		{
+			Ar.Logf(TEXT("  %-20s %8.1f %8.1f %8.1f %8.1f %10llu"), GetStageName(Stage), Summary.Min, Summary.Avg, Summary.P99, Summary.Max, History.GetTotalCount());
+		}
+	}
+}
+
+void FXboxFrontPanelStageHistory::Reset()
+{
+	for (int32 StageIndex = 0; StageIndex < static_cast<int32>(EXboxFrontPanelStage::Count); ++StageIndex)
+	{
+		XboxFrontPanelStats::FStageSamples& Samples = XboxFrontPanelStats::GetSamples(static_cast<EXboxFrontPanelStage>(StageIndex));
+
+		FScopeLock ScopeLock(&Samples.Lock);
+		Samples.History.Reset();
+	}
+}
+
+const TCHAR* FXboxFrontPanelStageHistory::GetStageName(EXboxFrontPanelStage Stage)
+{
+	switch (Stage)
+	{
+	case EXboxFrontPanelStage::DrawWindow:
+		return TEXT("DrawWindow");
+	case EXboxFrontPanelStage::EnqueueReadback:
+		return TEXT("EnqueueReadback");
+	case EXboxFrontPanelStage::MapStagingSurface:
+		return TEXT("MapStagingSurface");
+	case EXboxFrontPanelStage::ConvertLuminance:
+		return TEXT("ConvertLuminance");
+	case EXboxFrontPanelStage::PackCanvas:
+		return TEXT("PackCanvas");
+	case EXboxFrontPanelStage::DecodeAnimation:
+		return TEXT("DecodeAnimation");
+	case EXboxFrontPanelStage::PresentBuffer:
+		return TEXT("PresentBuffer");
+	case EXboxFrontPanelStage::GetButtonStates:
+		return TEXT("GetButtonStates");
+	case EXboxFrontPanelStage::GetLightStates:
+		return TEXT("GetLightStates");
+	case EXboxFrontPanelStage::SetLightStates:
+		return TEXT("SetLightStates");
+	case EXboxFrontPanelStage::PerfHud:
+		return TEXT("PerfHud");
+	default:
+		return TEXT("Unknown");
+	}
+}
+
+static FXboxFrontPanelDumpCommand DumpStageTimesCommand(
+	TEXT("XboxFrontPanel.DumpStageTimes"),
+	TEXT("Logs min, average, 99th percentile and max time of each front panel pipeline stage.  Usage: XboxFrontPanel.DumpStageTimes [Reset]"),
+	&FXboxFrontPanelStageHistory::Dump,
+	&FXboxFrontPanelStageHistory::Reset);
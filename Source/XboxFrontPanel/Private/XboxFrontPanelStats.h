@@ -0,0 +1,140 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DECLARE_STATS_GROUP(TEXT("XboxFrontPanel"), STATGROUP_XboxFrontPanel, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_EXTERN(XboxFrontPanel);
+
+/**
+* Pipeline stages timed by FRONT_PANEL_SCOPED_STAGE.  Each has a cycle stat, a CSV timing stat and a history of
+* recent samples that XboxFrontPanel.DumpStageTimes summarizes.
+*/
+enum class EXboxFrontPanelStage : uint8
+{
+	DrawWindow,
+	EnqueueReadback,
+	MapStagingSurface,
+	ConvertLuminance,
+	PackCanvas,
+	DecodeAnimation,
+	PresentBuffer,
+	GetButtonStates,
+	GetLightStates,
+	SetLightStates,
+	PerfHud,
+
+	Count
+};
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Draw Window"), STAT_XboxFrontPanel_DrawWindow, STATGROUP_XboxFrontPanel, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enqueue Readback"), STAT_XboxFrontPanel_EnqueueReadback, STATGROUP_XboxFrontPanel, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Map Staging Surface"), STAT_XboxFrontPanel_MapStagingSurface, STATGROUP_XboxFrontPanel, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Convert Luminance"), STAT_XboxFrontPanel_ConvertLuminance, STATGROUP_XboxFrontPanel, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pack Canvas"), STAT_XboxFrontPanel_PackCanvas, STATGROUP_XboxFrontPanel, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Decode Animation"), STAT_XboxFrontPanel_DecodeAnimation, STATGROUP_XboxFrontPanel, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Present Buffer"), STAT_XboxFrontPanel_PresentBuffer, STATGROUP_XboxFrontPanel, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Get Button States"), STAT_XboxFrontPanel_GetButtonStates, STATGROUP_XboxFrontPanel, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Get Light States"), STAT_XboxFrontPanel_GetLightStates, STATGROUP_XboxFrontPanel, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Set Light States"), STAT_XboxFrontPanel_SetLightStates, STATGROUP_XboxFrontPanel, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Perf HUD"), STAT_XboxFrontPanel_PerfHud, STATGROUP_XboxFrontPanel, );
+
+/** Min, average, median, 99th percentile and max of a FXboxFrontPanelSampleHistory. */
+struct FXboxFrontPanelSampleSummary
+{
+	float Min;
+	float Avg;
+	float P50;
+	float P99;
+	float Max;
+};
+
+/**
+* The most recent samples of one quantity, oldest overwritten first.  Not thread safe; owners guard it with their own
+* lock, and copy it out from under that lock to summarize.
+*/
+class FXboxFrontPanelSampleHistory
+{
+public:
+	explicit FXboxFrontPanelSampleHistory(int32 InMaxSamples);
+
+	void Add(float Sample);
+	void Reset();
+
+	/** @return		Samples currently held, at most the history's size. */
+	int32 Num() const { return Samples.Num(); }
+
+	/** @return		Samples added since the last reset, including those since overwritten. */
+	uint64 GetTotalCount() const { return TotalCount; }
+
+	/** @return		False if there are no samples. */
+	bool Summarize(FXboxFrontPanelSampleSummary& OutSummary) const;
+
+private:
+	TArray<float> Samples;
+	int32 MaxSamples;
+	int32 NextIndex;
+	uint64 TotalCount;
+};
+
+/**
+* Registers a console command that logs a history with Dump, then forgets it with Reset when given "Reset".
+*/
+class FXboxFrontPanelDumpCommand
+{
+public:
+	FXboxFrontPanelDumpCommand(const TCHAR* Name, const TCHAR* Help, void (*Dump)(FOutputDevice&), void (*Reset)());
+
+private:
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice Command;
+};
+
+/**
+* Keeps the most recent timings of each stage.  Stages may be recorded from any thread.
+*/
+class FXboxFrontPanelStageHistory
+{
+public:
+	/** Add one timing of a stage. */
+	static void Record(EXboxFrontPanelStage Stage, uint64 Cycles);
+
+	/** Log min, average and 99th percentile of every stage with samples. */
+	static void Dump(FOutputDevice& Ar);
+
+	/** Forget every sample. */
+	static void Reset();
+
+	static const TCHAR* GetStageName(EXboxFrontPanelStage Stage);
+};
+
+/** Records the lifetime of the scope into FXboxFrontPanelStageHistory. */
+class FXboxFrontPanelScopedStage
+{
+public:
+	explicit FXboxFrontPanelScopedStage(EXboxFrontPanelStage InStage)
+		: Stage(InStage)
+		, StartCycles(FPlatformTime::Cycles64())
+	{
+	}
+
+	~FXboxFrontPanelScopedStage()
+	{
+		FXboxFrontPanelStageHistory::Record(Stage, FPlatformTime::Cycles64() - StartCycles);
+	}
+
+private:
+	EXboxFrontPanelStage Stage;
+	uint64 StartCycles;
+};
+
+/** Time the rest of the enclosing scope as the given EXboxFrontPanelStage, in stats, CSV and the stage history. */
+#define FRONT_PANEL_SCOPED_STAGE(Stage) \
+	SCOPE_CYCLE_COUNTER(STAT_XboxFrontPanel_##Stage); \
+	CSV_SCOPED_TIMING_STAT(XboxFrontPanel, Stage); \
+	FXboxFrontPanelScopedStage ANONYMOUS_VARIABLE(FrontPanelStage)(EXboxFrontPanelStage::Stage)
@@ -0,0 +1,137 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelTextRenderer.h"
+#include "XboxFrontPanelCanvas.h"
+#include "XboxFrontPanelFont.h"
+
+FXboxFrontPanelTextRenderer::FXboxFrontPanelTextRenderer(UXboxFrontPanelFont* InFont, int32 InMaxCachedLayouts)
+	: Font(InFont)
+	, MaxCachedLayouts(FMath::Max(InMaxCachedLayouts, 1))
+	, UseCounter(0)
+{
+	check(Font != nullptr);
+}
+
+FIntPoint FXboxFrontPanelTextRenderer::MeasureText(const FString& Text)
+{
+	return GetLayout(Text).Size;
+}
+
+void FXboxFrontPanelTextRenderer::DrawText(FXboxFrontPanelCanvas& Canvas, const FString& Text, FIntPoint Position, uint8 Value, EXboxFrontPanelTextAlign Align)
+{
+	if (Font == nullptr)
+	{
+		return;
+	}
+
+	const FTextLayout& Layout = GetLayout(Text);
+	const uint8* Atlas = Font->AtlasPixels.GetData();
+	const int32 AtlasPitch = Font->AtlasWidth;
+
+	for (const FPlacedGlyph& Placed : Layout.Glyphs)
+	{
+		int32 LineX = Position.X;
+		if (Align != EXboxFrontPanelTextAlign::Left)
+		{
+			const int32 LineWidth = Layout.LineWidths[Placed.Line];
+			LineX -= Align == EXboxFrontPanelTextAlign::Center ? LineWidth / 2 : LineWidth;
+		}
+
+		const FXboxFrontPanelGlyph& Glyph = Font->Glyphs[Placed.GlyphIndex];
+		Canvas.BlitCoverage(Atlas + Glyph.AtlasY * AtlasPitch + Glyph.AtlasX, AtlasPitch, Glyph.Width, Glyph.Height, FIntPoint(LineX + Placed.X, Position.Y + Placed.Y), Value);
+	}
+}
+
+void FXboxFrontPanelTextRenderer::ClearCache()
+{
+	LayoutCache.Reset();
+}
+
+void FXboxFrontPanelTextRenderer::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObject(Font);
+}
+
+const FXboxFrontPanelTextRenderer::FTextLayout& FXboxFrontPanelTextRenderer::GetLayout(const FString& Text)
+{
+	++UseCounter;
+
+	if (FTextLayout* Cached = LayoutCache.Find(Text))
+	{
+		Cached->LastUsed = UseCounter;
+		return *Cached;
+	}
+
+	if (LayoutCache.Num() >= MaxCachedLayouts)
+	{
+		// Small enough that a linear search for the least recently used beats keeping a list in order
+		const FString* Oldest = nullptr;
+		uint64 OldestUse = MAX_uint64;
+		for (const TPair<FString, FTextLayout>& Entry : LayoutCache)
+		{
+			if (Entry.Value.LastUsed < OldestUse)
+			{
+				Oldest = &Entry.Key;
+				OldestUse = Entry.Value.LastUsed;
+			}
+		}
+		LayoutCache.Remove(FString(*Oldest));
+	}
+
+	FTextLayout& Layout = LayoutCache.Add(Text);
+	Layout.LastUsed = UseCounter;
+	Layout.Size = FIntPoint::ZeroValue;
+
+	if (Font == nullptr)
+	{
+		return Layout;
+	}
+
+	// Characters missing from the atlas show as '?' if that was baked, or as a gap otherwise
+	const int32 FallbackGlyph = Font->FindGlyph(TEXT('?'));
+	const int32 MissingAdvance = Font->LineHeight / 2;
+
+	int32 PenX = 0;
+	int32 Line = 0;
+	for (TCHAR Character : Text)
+	{
+		if (Character == TEXT('\n'))
+		{
+			Layout.LineWidths.Add(PenX);
+			Layout.Size.X = FMath::Max(Layout.Size.X, PenX);
+			PenX = 0;
+			++Line;
+			continue;
+		}
+
+		int32 GlyphIndex = Font->FindGlyph(Character);
+		if (GlyphIndex == INDEX_NONE)
+		{
+			GlyphIndex = FallbackGlyph;
+		}
+
+		if (GlyphIndex == INDEX_NONE)
+		{
+			PenX += MissingAdvance;
+			continue;
+		}
+
+		const FXboxFrontPanelGlyph& Glyph = Font->Glyphs[GlyphIndex];
+		if (Glyph.Width > 0 && Glyph.Height > 0)
+		{
+			FPlacedGlyph& Placed = Layout.Glyphs.AddDefaulted_GetRef();
+			Placed.GlyphIndex = GlyphIndex;
+			Placed.X = static_cast<int16>(PenX + Glyph.OffsetX);
+			Placed.Y = static_cast<int16>(Line * Font->LineHeight + Glyph.OffsetY);
+			Placed.Line = static_cast<int16>(Line);
+		}
+		PenX += Glyph.Advance;
+	}
+
+	Layout.LineWidths.Add(PenX);
+	Layout.Size.X = FMath::Max(Layout.Size.X, PenX);
+	Layout.Size.Y = (Line + 1) * Font->LineHeight;
+	return Layout;
+}
@@ -0,0 +1,218 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelViewerCommandlet.h"
+#include "XboxFrontPanelSharedMemoryRegion.h"
+#include "XboxFrontPanelSimulatedDevice.h"
+#include "XboxFrontPanelModulePrivate.h"
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace XboxFrontPanelViewer
+{
+	struct FButtonStep
+	{
+		EXboxFrontPanelButtons Buttons;
+		double Duration;
+	};
+
+	static bool ParseScript(const FString& Text, TArray<FButtonStep>& OutSteps)
+	{
+		TArray<FString> Args;
+		Text.ParseIntoArrayWS(Args);
+		for (const FString& Arg : Args)
+		{
+			FString ButtonText = Arg;
+			FString DurationText;
+			Arg.Split(TEXT(":"), &ButtonText, &DurationText);
+
+			FButtonStep& Step = OutSteps.AddDefaulted_GetRef();
+			Step.Duration = DurationText.IsEmpty() ? 0.1 : FCString::Atod(*DurationText);
+			if (!FXboxFrontPanelSimulatedDevice::ParseButtons(ButtonText, Step.Buttons))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Two screen pixels across and two down per character
+	static void LogAscii(const TArray<uint8>& Pixels, uint32 Width, uint32 Height)
+	{
+		static const TCHAR Ramp[] = TEXT(" .:-=+*#%@");
+		static const int32 RampLength = ARRAY_COUNT(Ramp) - 1;
+
+		FString Line;
+		for (uint32 Y = 0; Y + 1 < Height; Y += 2)
+		{
+			Line.Reset();
+			for (uint32 X = 0; X + 1 < Width; X += 2)
+			{
+				const uint8* Pixel = Pixels.GetData() + Y * Width + X;
+				const int32 Sum = Pixel[0] + Pixel[1] + Pixel[Width] + Pixel[Width + 1];
+				Line.AppendChar(Ramp[Sum * RampLength / (4 * 256)]);
+			}
+			UE_LOG(LogXboxFrontPanel, Display, TEXT("|%s|"), *Line);
+		}
+	}
+
+	static bool SavePgm(const FString& Filename, const TArray<uint8>& Pixels, uint32 Width, uint32 Height)
+	{
+		const FString Header = FString::Printf(TEXT("P5\n%u %u\n255\n"), Width, Height);
+
+		TArray<uint8> Image;
+		Image.Reserve(Header.Len() + Pixels.Num());
+		for (TCHAR Character : Header)
+		{
+			Image.Add(static_cast<uint8>(Character));
+		}
+		Image.Append(Pixels);
+
+		return FFileHelper::SaveArrayToFile(Image, *Filename);
+	}
+}
+
+UXboxFrontPanelViewerCommandlet::UXboxFrontPanelViewerCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UXboxFrontPanelViewerCommandlet::Main(const FString& Params)
+{
+	using namespace XboxFrontPanelViewer;
+
+	FString Name = XboxFrontPanelSharedMemory::DefaultName;
+	FString SaveDirectory;
+	FString ScriptText;
+	double Duration = 0.0;
+	float Rate = 60.0f;
+
+	FParse::Value(*Params, TEXT("Name="), Name);
+	FParse::Value(*Params, TEXT("Save="), SaveDirectory);
+	FParse::Value(*Params, TEXT("Buttons="), ScriptText);
+	FParse::Value(*Params, TEXT("Duration="), Duration);
+	FParse::Value(*Params, TEXT("Rate="), Rate);
+	const bool bAscii = FParse::Param(*Params, TEXT("Ascii"));
+
+	TArray<FButtonStep> Script;
+	if (Rate <= 0.0f || !ParseScript(ScriptText, Script))
+	{
+		UE_LOG(LogXboxFrontPanel, Error, TEXT("Usage: -run=XboxFrontPanelViewer [-Name=%s] [-Ascii] [-Save=<directory>] [-Buttons=\"Buttons[:Seconds] ...\"] [-Duration=<seconds>] [-Rate=60]  where Buttons is None or names joined with +, from Button1-5, Left, Right, Up, Down, Select."),
+			XboxFrontPanelSharedMemory::DefaultName);
+		return 1;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double EndTime = Duration > 0.0 ? StartTime + Duration : MAX_dbl;
+
+	TUniquePtr<FXboxFrontPanelSharedMemoryRegion> Region;
+	int64 FrameCount = 0;
+	uint32 FramesShown = 0;
+	uint32 FramesSkipped = 0;
+	EXboxFrontPanelLights Lights = EXboxFrontPanelLights::None;
+	TArray<uint8> Packed;
+	TArray<uint8> Pixels;
+
+	// The script starts once the title is attached, so its timing is relative to the panel it drives
+	int32 StepIndex = 0;
+	double StepEndTime = 0.0;
+	bool bWaitLogged = false;
+
+	while (!GIsRequestingExit)
+	{
+		const double CurrentTime = FPlatformTime::Seconds();
+		if (CurrentTime >= EndTime || (Duration <= 0.0 && Script.Num() > 0 && StepIndex >= Script.Num()))
+		{
+			break;
+		}
+
+		if (Region.IsValid() && !Region->IsValid())
+		{
+			UE_LOG(LogXboxFrontPanel, Display, TEXT("Front panel %s went away."), *Name);
+			Region.Reset();
+			bWaitLogged = false;
+		}
+
+		if (!Region.IsValid())
+		{
+			Region = FXboxFrontPanelSharedMemoryRegion::Open(Name);
+			if (!Region.IsValid())
+			{
+				if (!bWaitLogged)
+				{
+					UE_LOG(LogXboxFrontPanel, Display, TEXT("Waiting for a title sharing front panel %s (-XboxFrontPanelShare)..."), *Name);
+					bWaitLogged = true;
+				}
+				FPlatformProcess::Sleep(0.25f);
+				continue;
+			}
+
+			UE_LOG(LogXboxFrontPanel, Display, TEXT("Attached to front panel %s: %ux%u %s."),
+				*Name, Region->GetWidth(), Region->GetHeight(), FXboxFrontPanelLuminance::GetFormatName(Region->GetFormat()));
+			FrameCount = 0;
+			Lights = Region->GetLights();
+			StepEndTime = CurrentTime + (StepIndex < Script.Num() ? Script[StepIndex].Duration : 0.0);
+		}
+
+		if (StepIndex < Script.Num())
+		{
+			if (CurrentTime >= StepEndTime && ++StepIndex < Script.Num())
+			{
+				StepEndTime = CurrentTime + Script[StepIndex].Duration;
+			}
+			Region->InjectButtons(StepIndex < Script.Num() ? Script[StepIndex].Buttons : EXboxFrontPanelButtons::None);
+		}
+
+		const int64 PreviousFrameCount = FrameCount;
+		const bool bNewFrame = Region->ReadFrame(FrameCount, Packed);
+		const EXboxFrontPanelLights NewLights = Region->GetLights();
+		if (bNewFrame || NewLights != Lights)
+		{
+			Lights = NewLights;
+			UE_LOG(LogXboxFrontPanel, Display, TEXT("Frame %lld, lights 0x%02x, %.3fs."), FrameCount, static_cast<uint32>(Lights), CurrentTime - StartTime);
+		}
+
+		if (bNewFrame)
+		{
+			// Frames presented before we attached are not counted as skipped
+			++FramesShown;
+			if (PreviousFrameCount > 0)
+			{
+				FramesSkipped += static_cast<uint32>(FrameCount - PreviousFrameCount - 1);
+			}
+
+			const uint32 Width = Region->GetWidth();
+			const uint32 Height = Region->GetHeight();
+			Pixels.SetNumUninitialized(Width * Height);
+			FXboxFrontPanelLuminance::UnpackR8(Region->GetFormat(), Packed.GetData(), Region->GetRowBytes(), Pixels.GetData(), Width, Width, Height);
+
+			if (bAscii)
+			{
+				LogAscii(Pixels, Width, Height);
+			}
+
+			if (!SaveDirectory.IsEmpty())
+			{
+				const FString Filename = SaveDirectory / FString::Printf(TEXT("FrontPanel_%06lld.pgm"), FrameCount);
+				if (!SavePgm(Filename, Pixels, Width, Height))
+				{
+					UE_LOG(LogXboxFrontPanel, Error, TEXT("Cannot write %s."), *Filename);
+					return 1;
+				}
+			}
+		}
+
+		FPlatformProcess::Sleep(1.0f / Rate);
+	}
+
+	// Region's destructor lets go of any buttons still held
+	UE_LOG(LogXboxFrontPanel, Display, TEXT("Viewed %u front panel frames; %u were presented and replaced between polls."), FramesShown, FramesSkipped);
+	return 0;
+}
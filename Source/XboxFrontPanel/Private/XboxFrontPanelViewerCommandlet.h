@@ -0,0 +1,30 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "XboxFrontPanelViewerCommandlet.generated.h"
+
+/**
+* Watches and drives the front panel of a title on the same machine started with -XboxFrontPanelShare (see
+* XboxFrontPanelSharedMemory.h).
+*
+* Usage: -run=XboxFrontPanelViewer [-Name=XboxFrontPanel] [-Ascii] [-Save=<directory>]
+*		[-Buttons="Buttons[:Seconds] ..."] [-Duration=<seconds>] [-Rate=60]
+*
+* Each new frame is logged with the lights, drawn as text with -Ascii and written to a PGM image with -Save.
+* -Buttons holds buttons down on the panel, in the XboxFrontPanel.Sim.Buttons syntax.  Runs until -Duration has
+* passed, or else until the button script has played, or else until interrupted.  Waits for the title if it has not
+* started yet, and reattaches if it restarts.
+*/
+UCLASS()
+class UXboxFrontPanelViewerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UXboxFrontPanelViewerCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
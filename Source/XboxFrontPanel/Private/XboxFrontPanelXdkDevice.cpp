@@ -0,0 +1,173 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+
+#include "XboxFrontPanelXdkDevice.h"
+#include "XboxFrontPanelModulePrivate.h"
+
+#if FRONT_PANEL_XDK_ENABLED
+
+#include "Windows/ComPointer.h"
+
+#include "XboxOneAllowPlatformTypes.h"
+#include <d3d11_x.h>
+#define DXGI_FORMAT_DEFINED
+#include <XboxFrontPanel.h>
+
+static_assert(static_cast<uint32>(EXboxFrontPanelButtons::Button1) == XBOX_FRONT_PANEL_BUTTONS_BUTTON1, "EXboxFrontPanelButtons must match XBOX_FRONT_PANEL_BUTTONS");
+static_assert(static_cast<uint32>(EXboxFrontPanelButtons::Button5) == XBOX_FRONT_PANEL_BUTTONS_BUTTON5, "EXboxFrontPanelButtons must match XBOX_FRONT_PANEL_BUTTONS");
+static_assert(static_cast<uint32>(EXboxFrontPanelButtons::Left) == XBOX_FRONT_PANEL_BUTTONS_LEFT, "EXboxFrontPanelButtons must match XBOX_FRONT_PANEL_BUTTONS");
+static_assert(static_cast<uint32>(EXboxFrontPanelButtons::Right) == XBOX_FRONT_PANEL_BUTTONS_RIGHT, "EXboxFrontPanelButtons must match XBOX_FRONT_PANEL_BUTTONS");
+static_assert(static_cast<uint32>(EXboxFrontPanelButtons::Up) == XBOX_FRONT_PANEL_BUTTONS_UP, "EXboxFrontPanelButtons must match XBOX_FRONT_PANEL_BUTTONS");
+static_assert(static_cast<uint32>(EXboxFrontPanelButtons::Down) == XBOX_FRONT_PANEL_BUTTONS_DOWN, "EXboxFrontPanelButtons must match XBOX_FRONT_PANEL_BUTTONS");
+static_assert(static_cast<uint32>(EXboxFrontPanelButtons::Select) == XBOX_FRONT_PANEL_BUTTONS_SELECT, "EXboxFrontPanelButtons must match XBOX_FRONT_PANEL_BUTTONS");
+static_assert(static_cast<uint32>(EXboxFrontPanelLights::Light1) == XBOX_FRONT_PANEL_LIGHTS_LIGHT1, "EXboxFrontPanelLights must match XBOX_FRONT_PANEL_LIGHTS");
+static_assert(static_cast<uint32>(EXboxFrontPanelLights::Light5) == XBOX_FRONT_PANEL_LIGHTS_LIGHT5, "EXboxFrontPanelLights must match XBOX_FRONT_PANEL_LIGHTS");
+
+class FXboxFrontPanelXdkDevice :
+	public IXboxFrontPanelDevice
+{
+public:
+	explicit FXboxFrontPanelXdkDevice(IXboxFrontPanelControl* InFrontPanel)
+		: bPresentFailing(false)
+	{
+		FrontPanel.Attach(InFrontPanel);
+	}
+
+	virtual bool GetScreenInfo(uint32& OutWidth, uint32& OutHeight, EXboxFrontPanelScreenFormat& OutFormat) override
+	{
+		UINT32 ScreenWidth = 0;
+		UINT32 ScreenHeight = 0;
+		DXGI_FORMAT PlatformPixelFormat = DXGI_FORMAT_UNKNOWN;
+
+		bool bCanUseFrontScreen = true;
+		bCanUseFrontScreen &= SUCCEEDED(FrontPanel->GetScreenWidth(&ScreenWidth));
+		bCanUseFrontScreen &= SUCCEEDED(FrontPanel->GetScreenHeight(&ScreenHeight));
+		bCanUseFrontScreen &= SUCCEEDED(FrontPanel->GetScreenPixelFormat(&PlatformPixelFormat));
+
+		switch (PlatformPixelFormat)
+		{
+		case DXGI_FORMAT_R8_TYPELESS:
+		case DXGI_FORMAT_R8_UNORM:
+		case DXGI_FORMAT_R8_UINT:
+			OutFormat = EXboxFrontPanelScreenFormat::R8;
+			break;
+		case DXGI_FORMAT_R1_UNORM:
+			OutFormat = EXboxFrontPanelScreenFormat::R1Threshold;
+			break;
+		default:
+			bCanUseFrontScreen = false;
+			break;
+		}
+
+		OutWidth = ScreenWidth;
+		OutHeight = ScreenHeight;
+
+		if (!bCanUseFrontScreen)
+		{
+			UE_LOG(LogXboxFrontPanel, Warning, TEXT("Xbox Front Panel screen (%ux%u, pixel format %d) is not compatible with plugin render code."), ScreenWidth, ScreenHeight, PlatformPixelFormat);
+		}
+		return bCanUseFrontScreen;
+	}
+
+	virtual bool PresentBuffer(const uint8* Data, uint32 Size) override
+	{
+		HRESULT PresentResult = FrontPanel->PresentBuffer(Size, const_cast<BYTE*>(Data));
+		if (FAILED(PresentResult))
+		{
+			// Presents keep failing for as long as the user has the system display up, so only log the first of them
+			if (!bPresentFailing)
+			{
+				UE_LOG(LogXboxFrontPanel, Warning, TEXT("Failed to present to the Xbox Front Panel screen: %08X"), PresentResult);
+				bPresentFailing = true;
+			}
+			return false;
+		}
+
+		if (bPresentFailing)
+		{
+			UE_LOG(LogXboxFrontPanel, Log, TEXT("Presenting to the Xbox Front Panel screen again."));
+			bPresentFailing = false;
+		}
+		return true;
+	}
+
+	virtual bool GetButtonStates(EXboxFrontPanelButtons& OutButtons) override
+	{
+		XBOX_FRONT_PANEL_BUTTONS ButtonStates = XBOX_FRONT_PANEL_BUTTONS_NONE;
+		HRESULT ButtonStateResult = FrontPanel->GetButtonStates(&ButtonStates);
+		if (FAILED(ButtonStateResult))
+		{
+			UE_LOG(LogXboxFrontPanel, Warning, TEXT("Failed to read Xbox Front Panel button states: %08X"), ButtonStateResult);
+			return false;
+		}
+
+		OutButtons = static_cast<EXboxFrontPanelButtons>(ButtonStates);
+		return true;
+	}
+
+	virtual bool GetLightStates(EXboxFrontPanelLights& OutLights) override
+	{
+		XBOX_FRONT_PANEL_LIGHTS LightStates = XBOX_FRONT_PANEL_LIGHTS_NONE;
+		HRESULT GetLightStateResult = FrontPanel->GetLightStates(&LightStates);
+		if (FAILED(GetLightStateResult))
+		{
+			UE_LOG(LogXboxFrontPanel, Warning, TEXT("Failed reading Xbox Front Panel light state: %08X"), GetLightStateResult);
+			return false;
+		}
+
+		OutLights = static_cast<EXboxFrontPanelLights>(LightStates);
+		return true;
+	}
+
+	virtual bool SetLightStates(EXboxFrontPanelLights Lights) override
+	{
+		HRESULT SetLightStateResult = FrontPanel->SetLightStates(static_cast<XBOX_FRONT_PANEL_LIGHTS>(Lights));
+		if (FAILED(SetLightStateResult))
+		{
+			UE_LOG(LogXboxFrontPanel, Warning, TEXT("Failed setting Xbox Front Panel light state: %08X"), SetLightStateResult);
+			return false;
+		}
+		return true;
+	}
+
+	virtual const TCHAR* GetName() const override
+	{
+		return TEXT("XDK");
+	}
+
+private:
+	TComPtr<IXboxFrontPanelControl> FrontPanel;
+
+	// Set from a failed present until the next one succeeds.  Presents are serialized by the module.
+	bool bPresentFailing;
+};
+
+TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> CreateXboxFrontPanelXdkDevice()
+{
+	// Note: When IsXboxFrontPanelAvailable returns TRUE it also transitions the front screen to title
+	// ownership.  The screen will be blank until the title provides a widget to draw (or the user holds
+	// the directional button to flip back to the system display)
+	if (IsXboxFrontPanelAvailable() == TRUE)
+	{
+		IXboxFrontPanelControl* FrontPanelRaw = nullptr;
+		if (SUCCEEDED(GetDefaultXboxFrontPanel(&FrontPanelRaw)))
+		{
+			check(FrontPanelRaw);
+			return MakeShared<FXboxFrontPanelXdkDevice, ESPMode::ThreadSafe>(FrontPanelRaw);
+		}
+	}
+
+	return nullptr;
+}
+
+#include "XboxOneHidePlatformTypes.h"
+
+#else
+
+TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> CreateXboxFrontPanelXdkDevice()
+{
+	return nullptr;
+}
+
+#endif // FRONT_PANEL_XDK_ENABLED
@@ -0,0 +1,15 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "XboxFrontPanelDevice.h"
+
+/**
+* Create the backend for the real front panel through IXboxFrontPanelControl.  Transitions the screen to title
+* ownership as a side effect.
+*
+* @return		Null when the XDK front panel is unavailable, including on every other platform.
+*/
+TSharedPtr<IXboxFrontPanelDevice, ESPMode::ThreadSafe> CreateXboxFrontPanelXdkDevice();
@@ -0,0 +1,142 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+* Cooked front panel animation file layout, all little endian:
+*
+*	FXboxFrontPanelAnimationHeader
+*	Frame records, each Height rows of:
+*		uint8 EXboxFrontPanelAnimationRow, then for Raw rows Width pixels, for Rle rows tokens covering Width pixels
+*	FXboxFrontPanelAnimationIndexEntry for every frame, at Header.IndexOffset
+*
+* Pixels are 8bpp luminance.  Keyframes never use Skip rows so playback can start at any of them.  A delta frame
+* identical to the one before it has a zero sized record.
+*
+* An Rle token is a control byte C.  C below 128 is followed by C + 1 literal pixels; otherwise the next byte is
+* repeated C - 126 times.
+*/
+namespace XboxFrontPanelAnimation
+{
+	static const uint32 Magic = 0x4E415046; // "FPAN"
+	static const uint32 Version = 1;
+
+	/** Recommended extension for cooked files. */
+	static const TCHAR* const Extension = TEXT(".fpanim");
+}
+
+enum class EXboxFrontPanelAnimationRow : uint8
+{
+	/** Row is unchanged from the previous frame. */
+	Skip,
+
+	/** Width literal pixels. */
+	Raw,
+
+	/** Run length tokens. */
+	Rle
+};
+
+struct FXboxFrontPanelAnimationHeader
+{
+	uint32 Magic;
+	uint32 Version;
+	uint32 Width;
+	uint32 Height;
+	float FrameRate;
+	uint32 FrameCount;
+	uint64 IndexOffset;
+
+	/** Bytes the header takes in a file. */
+	static const int64 SerializedSize = 32;
+
+	friend FArchive& operator<<(FArchive& Ar, FXboxFrontPanelAnimationHeader& Header)
+	{
+		return Ar << Header.Magic << Header.Version << Header.Width << Header.Height << Header.FrameRate << Header.FrameCount << Header.IndexOffset;
+	}
+};
+
+struct FXboxFrontPanelAnimationIndexEntry
+{
+	uint64 Offset;
+	uint32 Size;
+	uint32 bKeyframe;
+
+	/** Bytes each entry takes in a file. */
+	static const int64 SerializedSize = 16;
+
+	friend FArchive& operator<<(FArchive& Ar, FXboxFrontPanelAnimationIndexEntry& Entry)
+	{
+		return Ar << Entry.Offset << Entry.Size << Entry.bKeyframe;
+	}
+};
+
+/**
+* Encodes frame records in the row format above.  Also used for anything else that stores a sequence of panel frames,
+* such as captures (see XboxFrontPanelCapture.h).
+*/
+class XBOXFRONTPANEL_API FXboxFrontPanelAnimationEncoder
+{
+public:
+	/**
+	* Append one frame record to Out.
+	*
+	* @param PreviousFrame	Width x Height frame the record is a delta against, tightly packed.  Updated to this frame.
+	* @param bKeyframe		Encode every row, ignoring PreviousFrame.
+	*
+	* @return		False if the frame matched PreviousFrame, in which case nothing was appended.
+	*/
+	static bool EncodeFrame(const uint8* Pixels, int32 Pitch, uint8* PreviousFrame, int32 Width, int32 Height, bool bKeyframe, TArray<uint8>& Out);
+};
+
+/**
+* Encodes 8bpp frames into a cooked front panel animation.
+*/
+class XBOXFRONTPANEL_API FXboxFrontPanelAnimationWriter
+{
+public:
+	/**
+	* @param InKeyframeInterval	Frames between keyframes.  Shorter intervals seek faster, longer ones compress better.
+	*/
+	FXboxFrontPanelAnimationWriter(int32 InWidth, int32 InHeight, float InFrameRate, int32 InKeyframeInterval);
+
+	/** Append a frame of Width x Height luminance pixels, Pitch bytes apart. */
+	void AddFrame(const uint8* Pixels, int32 Pitch);
+
+	int32 GetFrameCount() const { return Index.Num(); }
+
+	/** @return		The complete file contents. */
+	TArray<uint8> Finish() const;
+
+	bool SaveToFile(const FString& Filename) const;
+
+private:
+	int32 Width;
+	int32 Height;
+	float FrameRate;
+	int32 KeyframeInterval;
+
+	TArray<uint8> FrameData;
+	TArray<FXboxFrontPanelAnimationIndexEntry> Index;
+	TArray<uint8> PreviousFrame;
+};
+
+/**
+* Decodes frame records of a cooked front panel animation.
+*/
+class XBOXFRONTPANEL_API FXboxFrontPanelAnimationDecoder
+{
+public:
+	/**
+	* Apply one frame record on top of the previous frame.
+	*
+	* @param Dest		Previous frame, overwritten with this one.  Must already hold a frame unless Record is a keyframe.
+	* @param DestPitch	Distance in bytes between rows of Dest.
+	*
+	* @return		False if the record is malformed, in which case Dest is partly updated.
+	*/
+	static bool DecodeFrame(const uint8* Record, int64 RecordSize, uint8* Dest, int32 DestPitch, int32 Width, int32 Height);
+};
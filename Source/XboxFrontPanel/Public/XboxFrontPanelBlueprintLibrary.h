@@ -5,6 +5,7 @@
 
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "XboxFrontPanelModule.h"
+#include "XboxFrontPanelLightSequence.h"
 #include "XboxFrontPanelBlueprintLibrary.generated.h"
 
 
@@ -27,6 +28,36 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Xbox Front Panel", meta=(DevelopmentOnly))
 	static void SetScreenWidget(UUserWidget* Widget);
 
+	/**
+	* Request that the front panel screen widget be painted on the next tick.  Only needed when
+	* XboxFrontPanel.RedrawMode is 1 and the widget changes in a way the module cannot detect, for example
+	* text or images updated from game code.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Xbox Front Panel", meta = (DevelopmentOnly))
+	static void MarkScreenDirty();
+
+	/**
+	* Create the front panel screen's rendering resources ahead of the first SetScreenWidget, for example during
+	* loading, so that showing panel UI does not hitch.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Xbox Front Panel", meta = (DevelopmentOnly))
+	static bool PrewarmScreen();
+
+	/**
+	* Register a UMG widget as a named front panel screen page.  Pages keep their layout and last frame, so switching
+	* between them with ShowScreen does not hitch.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Xbox Front Panel", meta = (DevelopmentOnly))
+	static bool RegisterScreen(FName Name, UUserWidget* Widget);
+
+	/** Forget a front panel screen page, clearing the screen if it is showing. */
+	UFUNCTION(BlueprintCallable, Category = "Xbox Front Panel", meta = (DevelopmentOnly))
+	static void UnregisterScreen(FName Name);
+
+	/** Show a registered front panel screen page, putting its last frame up straight away. */
+	UFUNCTION(BlueprintCallable, Category = "Xbox Front Panel", meta = (DevelopmentOnly))
+	static bool ShowScreen(FName Name);
+
 	/**
 	* Switch the light associated with a front panel button on or off.
 	*
@@ -46,6 +77,49 @@ public:
 	UFUNCTION(BlueprintPure , Category = "Xbox Front Panel")
 	static bool GetButtonLightState(EXboxFrontPanelButtonLight Light);
 
+	/**
+	* Set every front panel button light at once.  Cheaper than several SetButtonLightState calls when more than
+	* one light changes, though all light changes within a tick are sent to the device together either way.
+	*
+	* @param Mask	Lights to switch on.  Any light not in the mask is switched off.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Xbox Front Panel", meta = (DevelopmentOnly))
+	static void SetButtonLightMask(UPARAM(meta = (Bitmask, BitmaskEnum = "EXboxFrontPanelButtonLight")) int32 Mask);
+
+	/**
+	* Query every front panel button light at once.
+	*
+	* @return		Lights that are on.  Zero if the front panel is not currently available.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Xbox Front Panel", meta = (Bitmask, BitmaskEnum = "EXboxFrontPanelButtonLight"))
+	static int32 GetButtonLightMask();
+
+	/**
+	* Start playing a light sequence, or restart it if it is already playing.  The lights it covers follow the
+	* sequence instead of SetButtonLightState until it stops.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Xbox Front Panel", meta = (DevelopmentOnly))
+	static void PlayLightSequence(UXboxFrontPanelLightSequence* Sequence);
+
+	/** Stop a playing light sequence. */
+	UFUNCTION(BlueprintCallable, Category = "Xbox Front Panel", meta = (DevelopmentOnly))
+	static void StopLightSequence(UXboxFrontPanelLightSequence* Sequence);
+
+	/** Stop every playing light sequence. */
+	UFUNCTION(BlueprintCallable, Category = "Xbox Front Panel", meta = (DevelopmentOnly))
+	static void StopAllLightSequences();
+
+	/**
+	* Play a cooked front panel animation file at its authored frame rate, without UMG or the GPU.  Ignored while a
+	* screen widget is set.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Xbox Front Panel", meta = (DevelopmentOnly))
+	static bool PlayAnimation(const FString& Filename, bool bLoop);
+
+	/** Stop the playing front panel animation, leaving the current frame on the screen. */
+	UFUNCTION(BlueprintCallable, Category = "Xbox Front Panel", meta = (DevelopmentOnly))
+	static void StopAnimation();
+
 	/**
 	* Checks to see whether or not front panel features are available in the current runtime environment.
 	* When not available, all other methods on this interface are no-ops with get-style methods returning
@@ -0,0 +1,98 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+* How Blit combines source pixels with the canvas.
+*/
+enum class EXboxFrontPanelCanvasBlend : uint8
+{
+	/** Source replaces the canvas. */
+	Copy,
+
+	/** Brighter of source and canvas.  Black source pixels leave the canvas untouched. */
+	Lighten,
+
+	/** Darker of source and canvas.  White source pixels leave the canvas untouched. */
+	Darken
+};
+
+/**
+* A CPU drawing surface holding one byte of luminance per pixel, for status screens that do not need Slate.
+* Presenting a canvas (see IXboxFrontPanelModule::PresentCanvas) packs it straight into the panel's pixel format,
+* with no render target, GPU copy or readback.
+*
+* Every drawing call is clipped to the clip rect, which defaults to the whole canvas.  Rects are half open: Min is
+* the first pixel inside and Max the first pixel past the edge.
+*/
+class XBOXFRONTPANEL_API FXboxFrontPanelCanvas
+{
+public:
+	/** Create a canvas cleared to black.  Use IXboxFrontPanelModule::GetScreenSize to match the panel. */
+	FXboxFrontPanelCanvas(int32 InWidth, int32 InHeight);
+
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+
+	/** @return		Distance in bytes between rows of GetData. */
+	int32 GetPitch() const { return Pitch; }
+
+	const uint8* GetData() const { return Pixels.GetData(); }
+	uint8* GetData() { return Pixels.GetData(); }
+
+	/** Restrict drawing to Rect, intersected with the canvas bounds. */
+	void SetClipRect(const FIntRect& Rect);
+
+	/** Allow drawing anywhere on the canvas again. */
+	void ResetClipRect();
+
+	const FIntRect& GetClipRect() const { return ClipRect; }
+
+	/** Set every pixel of the canvas, ignoring the clip rect. */
+	void Clear(uint8 Value);
+
+	void SetPixel(int32 X, int32 Y, uint8 Value);
+
+	/** @return		The pixel at X, Y, or zero outside the canvas. */
+	uint8 GetPixel(int32 X, int32 Y) const;
+
+	void FillRect(const FIntRect& Rect, uint8 Value);
+
+	/** Draw the one pixel wide outline just inside Rect. */
+	void DrawRect(const FIntRect& Rect, uint8 Value);
+
+	/** Draw a one pixel wide line including both end points. */
+	void DrawLine(FIntPoint Start, FIntPoint End, uint8 Value);
+
+	/**
+	* Copy an 8bpp luminance bitmap onto the canvas.
+	*
+	* @param Src		First pixel of the bitmap.
+	* @param SrcPitch	Distance in bytes between bitmap rows.
+	* @param SrcWidth	Bitmap width in pixels.
+	* @param SrcHeight	Bitmap height in pixels.
+	* @param Dest		Canvas position of the bitmap's top left pixel.  May be partly or wholly off the canvas.
+	* @param Blend		How bitmap pixels are combined with the canvas.
+	*/
+	void Blit(const uint8* Src, int32 SrcPitch, int32 SrcWidth, int32 SrcHeight, FIntPoint Dest, EXboxFrontPanelCanvasBlend Blend = EXboxFrontPanelCanvasBlend::Copy);
+
+	/**
+	* Paint Value through an 8bpp coverage mask, such as an antialiased glyph.  Each canvas pixel moves towards Value
+	* by the mask's coverage, where 255 replaces the pixel and 0 leaves it untouched.
+	*/
+	void BlitCoverage(const uint8* Src, int32 SrcPitch, int32 SrcWidth, int32 SrcHeight, FIntPoint Dest, uint8 Value);
+
+	/** Blit another canvas, or the part of it inside SrcRect. */
+	void Blit(const FXboxFrontPanelCanvas& Src, FIntPoint Dest, EXboxFrontPanelCanvasBlend Blend = EXboxFrontPanelCanvasBlend::Copy);
+	void Blit(const FXboxFrontPanelCanvas& Src, const FIntRect& SrcRect, FIntPoint Dest, EXboxFrontPanelCanvasBlend Blend = EXboxFrontPanelCanvasBlend::Copy);
+
+private:
+	int32 Width;
+	int32 Height;
+	int32 Pitch;
+	FIntRect ClipRect;
+	TArray<uint8> Pixels;
+};
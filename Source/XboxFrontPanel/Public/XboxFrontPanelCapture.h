@@ -0,0 +1,60 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+* Front panel capture file layout, all little endian:
+*
+*	FXboxFrontPanelCaptureHeader
+*	Records until the end of the file, each:
+*		uint8 EXboxFrontPanelCaptureRecord
+*		double seconds since the capture started
+*		Frame:		uint32 size, then a frame record in the animation row format (see XboxFrontPanelAnimation.h)
+*		Buttons:	uint32 EXboxFrontPanelButtons, then uint32 frames presented before the change (version 2 on)
+*
+* Frames are the buffers given to PresentBuffer, in the screen's format, treated as RowBytes x Height 8 bit images.
+* The first frame is a keyframe and each later frame is a delta against the one before it.  Button samples are
+* written only when they differ from the previous sample, which is all the input engine can observe of them.  Replay
+* releases them by the frame count rather than the time, so input lands between the same frames however fast the
+* replay runs.  Version 1 captures have no frame count; it is taken from the order of the records instead.
+*/
+namespace XboxFrontPanelCapture
+{
+	static const uint32 Magic = 0x50435046; // "FPCP"
+	static const uint32 Version = 2;
+
+	/** Recommended extension for capture files. */
+	static const TCHAR* const Extension = TEXT(".fpcap");
+}
+
+enum class EXboxFrontPanelCaptureRecord : uint8
+{
+	/** A buffer given to PresentBuffer. */
+	Frame,
+
+	/** A GetButtonStates result that differs from the one before it. */
+	Buttons
+};
+
+struct FXboxFrontPanelCaptureHeader
+{
+	uint32 Magic;
+	uint32 Version;
+	uint32 Width;
+	uint32 Height;
+
+	/** EXboxFrontPanelScreenFormat the device reported. */
+	uint32 Format;
+	uint32 RowBytes;
+
+	/** Bytes the header takes in a file. */
+	static const int64 SerializedSize = 24;
+
+	friend FArchive& operator<<(FArchive& Ar, FXboxFrontPanelCaptureHeader& Header)
+	{
+		return Ar << Header.Magic << Header.Version << Header.Width << Header.Height << Header.Format << Header.RowBytes;
+	}
+};
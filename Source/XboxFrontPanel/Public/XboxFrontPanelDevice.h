@@ -0,0 +1,84 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "XboxFrontPanelLuminance.h"
+
+/**
+* Front panel buttons as a bitmask.  Values match XBOX_FRONT_PANEL_BUTTONS.
+*/
+enum class EXboxFrontPanelButtons : uint32
+{
+	None = 0,
+	Button1 = 0x1,
+	Button2 = 0x2,
+	Button3 = 0x4,
+	Button4 = 0x8,
+	Button5 = 0x10,
+	Left = 0x20,
+	Right = 0x40,
+	Up = 0x80,
+	Down = 0x100,
+	Select = 0x200,
+	All = 0x3FF
+};
+ENUM_CLASS_FLAGS(EXboxFrontPanelButtons);
+
+/**
+* Front panel button lights as a bitmask.  Values match XBOX_FRONT_PANEL_LIGHTS.
+*/
+enum class EXboxFrontPanelLights : uint32
+{
+	None = 0,
+	Light1 = 0x1,
+	Light2 = 0x2,
+	Light3 = 0x4,
+	Light4 = 0x8,
+	Light5 = 0x10,
+	All = 0x1F
+};
+ENUM_CLASS_FLAGS(EXboxFrontPanelLights);
+
+/**
+* Hardware (or simulated hardware) behind the front panel module.  The module owns the render, readback,
+* input and light logic and only talks to the panel through this interface.
+*
+* PresentBuffer may be called from the game thread, the render thread or the present worker; the module serializes
+* those calls, so a device never sees two at once.  GetButtonStates may also be called from the button sampling
+* thread.  Everything else is called on the game thread.  Methods return false when the device call fails, after
+* logging the reason.
+*/
+class IXboxFrontPanelDevice
+{
+public:
+	virtual ~IXboxFrontPanelDevice() {}
+
+	/**
+	* Query the screen attached to the panel.
+	*
+	* @param OutFormat	Layout PresentBuffer expects.  One bit screens report R1Threshold; the module decides
+	*					whether to dither.
+	*
+	* @return		False if the panel has no screen, or its format is not one the module can produce.
+	*/
+	virtual bool GetScreenInfo(uint32& OutWidth, uint32& OutHeight, EXboxFrontPanelScreenFormat& OutFormat) = 0;
+
+	/** Replace the contents of the screen.  Size is the row bytes of the screen format times its height. */
+	virtual bool PresentBuffer(const uint8* Data, uint32 Size) = 0;
+
+	virtual bool GetButtonStates(EXboxFrontPanelButtons& OutButtons) = 0;
+
+	virtual bool GetLightStates(EXboxFrontPanelLights& OutLights) = 0;
+	virtual bool SetLightStates(EXboxFrontPanelLights Lights) = 0;
+
+	/** @return		Name of the backend, for logging. */
+	virtual const TCHAR* GetName() const = 0;
+
+	/** @return		True for FXboxFrontPanelSimulatedDevice. */
+	virtual bool IsSimulated() const { return false; }
+
+	/** @return		The device this one forwards to, for devices that wrap another such as the capture device. */
+	virtual IXboxFrontPanelDevice* GetInnerDevice() { return nullptr; }
+};
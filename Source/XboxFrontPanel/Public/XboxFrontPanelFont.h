@@ -0,0 +1,131 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "Engine/DataAsset.h"
+#include "Fonts/SlateFontInfo.h"
+#include "XboxFrontPanelFont.generated.h"
+
+/**
+* Where one character sits in a baked front panel font atlas.
+*/
+USTRUCT()
+struct XBOXFRONTPANEL_API FXboxFrontPanelGlyph
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Character;
+
+	/** Top left of the glyph's trimmed bitmap in the atlas. */
+	UPROPERTY()
+	uint16 AtlasX;
+
+	UPROPERTY()
+	uint16 AtlasY;
+
+	/** Size of the trimmed bitmap.  Zero for blank characters such as space. */
+	UPROPERTY()
+	uint8 Width;
+
+	UPROPERTY()
+	uint8 Height;
+
+	/** Offset of the bitmap from the pen position, which is the top left of the line. */
+	UPROPERTY()
+	int16 OffsetX;
+
+	UPROPERTY()
+	int16 OffsetY;
+
+	/** Pixels the pen moves right after this character. */
+	UPROPERTY()
+	uint8 Advance;
+
+	FXboxFrontPanelGlyph()
+		: Character(0)
+		, AtlasX(0)
+		, AtlasY(0)
+		, Width(0)
+		, Height(0)
+		, OffsetX(0)
+		, OffsetY(0)
+		, Advance(0)
+	{
+	}
+};
+
+/**
+* A font face and size pre-rendered to an 8bpp coverage atlas, so front panel text can be drawn on an
+* FXboxFrontPanelCanvas without Slate.  See FXboxFrontPanelTextRenderer.
+*
+* Bake in the editor by setting SourceFont and SourceCharacters and clicking Bake, then save the asset.  Bake can also
+* be called at runtime while Slate is up, at the cost of one render target readback.
+*/
+UCLASS(BlueprintType)
+class XBOXFRONTPANEL_API UXboxFrontPanelFont : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UXboxFrontPanelFont();
+
+#if WITH_EDITORONLY_DATA
+	/** Font face and size to bake. */
+	UPROPERTY(EditAnywhere, Category = "Baking")
+	FSlateFontInfo SourceFont;
+
+	/** Every character the atlas should contain. */
+	UPROPERTY(EditAnywhere, Category = "Baking")
+	FString SourceCharacters;
+#endif
+
+#if WITH_EDITOR
+	/** Rebuild the atlas from SourceFont and SourceCharacters. */
+	UFUNCTION(CallInEditor, Category = "Baking")
+	void BakeFromSource();
+#endif
+
+	/**
+	* Render every character of Characters in FontInfo and replace the atlas with the result.  Game thread only, and
+	* requires Slate.
+	*
+	* @return		True if the atlas was baked.
+	*/
+	bool Bake(const FSlateFontInfo& FontInfo, const FString& Characters);
+
+	/** @return		Index into Glyphs of Character, or INDEX_NONE if it was not baked. */
+	int32 FindGlyph(TCHAR Character) const;
+
+	/** Sorted by character. */
+	UPROPERTY(VisibleAnywhere, Category = "Atlas")
+	TArray<FXboxFrontPanelGlyph> Glyphs;
+
+	/** Coverage of every glyph, one byte per pixel, AtlasWidth bytes per row. */
+	UPROPERTY()
+	TArray<uint8> AtlasPixels;
+
+	UPROPERTY(VisibleAnywhere, Category = "Atlas")
+	int32 AtlasWidth;
+
+	UPROPERTY(VisibleAnywhere, Category = "Atlas")
+	int32 AtlasHeight;
+
+	/** Distance in pixels between the tops of consecutive lines. */
+	UPROPERTY(VisibleAnywhere, Category = "Atlas")
+	int32 LineHeight;
+
+	/** Distance in pixels from the top of a line down to its baseline. */
+	UPROPERTY(VisibleAnywhere, Category = "Atlas")
+	int32 Baseline;
+
+public:
+	virtual void PostLoad() override;
+
+private:
+	void BuildLookup();
+
+	// Glyph index of each ASCII character, so common text never searches Glyphs
+	int16 AsciiGlyphs[128];
+};
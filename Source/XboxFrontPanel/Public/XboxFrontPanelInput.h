@@ -0,0 +1,98 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "XboxFrontPanelDevice.h"
+
+/**
+* Auto-repeat timing for a held front panel button.  The first repeat follows InitialDelay seconds after the press.
+* Each later gap is Interval scaled by Acceleration once per repeat so far, never shorter than MinInterval.  An
+* Acceleration below one speeds repeats up the longer the button is held.
+*/
+struct FXboxFrontPanelButtonRepeat
+{
+	float InitialDelay;
+	float Interval;
+	float MinInterval;
+	float Acceleration;
+
+	/** Disable repeats entirely with an Interval of zero or less. */
+	FXboxFrontPanelButtonRepeat(float InInitialDelay = 0.2f, float InInterval = 0.1f, float InMinInterval = 0.1f, float InAcceleration = 1.0f)
+		: InitialDelay(InInitialDelay)
+		, Interval(InInterval)
+		, MinInterval(InMinInterval)
+		, Acceleration(InAcceleration)
+	{
+	}
+};
+
+/** A key pressed when every button in Buttons is held, and released when any of them is let go. */
+struct FXboxFrontPanelButtonChord
+{
+	EXboxFrontPanelButtons Buttons;
+	FName KeyName;
+};
+
+/** A key pressed once Button has been held for HoldTime seconds, and released with it. */
+struct FXboxFrontPanelButtonLongPress
+{
+	EXboxFrontPanelButtons Button;
+	float HoldTime;
+	FName KeyName;
+};
+
+/** Which of the key events Slate receives are offered to the front panel screen widget. */
+enum class EXboxFrontPanelKeyRouting : uint8
+{
+	/** Only keys the panel itself sends: each button's key and the configured chord and long press keys. */
+	PanelKeys,
+
+	/** Panel keys, plus the keys named in RoutedKeyNames, typically gamepad keys that also drive the panel UI. */
+	PanelAndSelectedKeys,
+
+	/** Every key from every device. */
+	AllKeys
+};
+
+/**
+* How front panel buttons are turned into Slate key events.  Every button always sends its own key (see
+* XboxFrontPanelKeyNames); chords and long presses send additional keys, which the title registers with EKeys.
+*/
+struct FXboxFrontPanelInputConfig
+{
+	static const int32 NumButtons = 10;
+
+	/** Indexed by bit position in EXboxFrontPanelButtons, Button1 first. */
+	FXboxFrontPanelButtonRepeat Repeat[NumButtons];
+
+	TArray<FXboxFrontPanelButtonChord> Chords;
+	TArray<FXboxFrontPanelButtonLongPress> LongPresses;
+
+	/**
+	* Keys outside the routing are passed straight on to the rest of Slate without being offered to the screen
+	* widget, which keeps the panel off the cost of ordinary keyboard and gamepad input.
+	*/
+	EXboxFrontPanelKeyRouting KeyRouting;
+
+	/** Extra keys offered to the screen widget under EXboxFrontPanelKeyRouting::PanelAndSelectedKeys. */
+	TArray<FName> RoutedKeyNames;
+
+	FXboxFrontPanelInputConfig()
+		: KeyRouting(EXboxFrontPanelKeyRouting::PanelKeys)
+	{
+	}
+
+	/** Apply the same repeat timing to every button in Buttons. */
+	void SetRepeat(EXboxFrontPanelButtons Buttons, const FXboxFrontPanelButtonRepeat& InRepeat)
+	{
+		for (int32 Index = 0; Index < NumButtons; ++Index)
+		{
+			if (EnumHasAnyFlags(Buttons, static_cast<EXboxFrontPanelButtons>(1u << Index)))
+			{
+				Repeat[Index] = InRepeat;
+			}
+		}
+	}
+};
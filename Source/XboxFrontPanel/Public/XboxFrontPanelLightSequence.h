@@ -0,0 +1,85 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "Engine/DataAsset.h"
+#include "XboxFrontPanelModule.h"
+#include "XboxFrontPanelLightSequence.generated.h"
+
+/**
+* Square wave driving one front panel button light.  Blinks, pulses and chases are all channels with different
+* periods, duty cycles and phases.
+*/
+USTRUCT(BlueprintType)
+struct XBOXFRONTPANEL_API FXboxFrontPanelLightChannel
+{
+	GENERATED_BODY()
+
+	/** Light driven by this channel. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Light")
+	EXboxFrontPanelButtonLight Light;
+
+	/** Seconds per on/off cycle.  Zero or less holds the light steadily on (any duty cycle) or off (none). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Light", meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float Period;
+
+	/** Fraction of each period the light is on. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Light", meta = (ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "1.0"))
+	float DutyCycle;
+
+	/** Fraction of a period by which this channel leads the start of the sequence.  Stagger these for a chase. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Light", meta = (ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "1.0"))
+	float Phase;
+
+	FXboxFrontPanelLightChannel()
+		: Light(EXboxFrontPanelButtonLight::Button1)
+		, Period(1.0f)
+		, DutyCycle(0.5f)
+		, Phase(0.0f)
+	{
+	}
+
+	/** @return		True if the light is on Elapsed seconds into the sequence. */
+	bool IsOn(double Elapsed) const;
+};
+
+/**
+* Declarative pattern for the front panel button lights, played by the module without any per-frame script.  Lights
+* with no channel in a sequence are left to lower priority sequences, or to SetButtonLightState when none cover them.
+*/
+UCLASS(BlueprintType)
+class XBOXFRONTPANEL_API UXboxFrontPanelLightSequence : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UXboxFrontPanelLightSequence();
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Light Sequence")
+	TArray<FXboxFrontPanelLightChannel> Channels;
+
+	/** Repeat until stopped.  Otherwise the sequence stops by itself after Duration. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Light Sequence")
+	bool bLooping;
+
+	/** Seconds a non-looping sequence plays for.  Zero plays the longest channel period once. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Light Sequence", meta = (ClampMin = "0.0", UIMin = "0.0", EditCondition = "!bLooping"))
+	float Duration;
+
+	/** Layer of this sequence.  For each light, the highest priority playing sequence with a channel for it wins. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Light Sequence")
+	int32 Priority;
+
+	/** @return		Seconds until a non-looping sequence finishes. */
+	float GetPlayLength() const;
+
+	/**
+	* Evaluate the sequence.
+	*
+	* @param OutCovered		Bit N set for each EXboxFrontPanelButtonLight N with a channel in this sequence.
+	*
+	* @return		Bit N set for each covered light that is on Elapsed seconds in.
+	*/
+	int32 Evaluate(double Elapsed, int32& OutCovered) const;
+};
@@ -0,0 +1,186 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+* Available implementations of the 8bpp luminance conversion used to feed the front panel screen.
+*/
+enum class EXboxFrontPanelLuminanceKernel : uint8
+{
+	/** Portable reference implementation.  Always available. */
+	Scalar,
+
+	/** 128-bit implementation, 16 pixels per iteration. */
+	SSE41,
+
+	/** 256-bit implementation, 32 pixels per iteration. */
+	AVX2,
+
+	/** 512-bit implementation, 64 pixels per iteration.  Requires AVX-512F and AVX-512BW. */
+	AVX512,
+
+	Count
+};
+
+/**
+* Arithmetic used by the luminance conversion.
+*/
+enum class EXboxFrontPanelLuminanceMode : uint8
+{
+	/** Single precision weights.  Results may differ by one between kernels at rounding ties. */
+	Float,
+
+	/** 14 bit fixed point weights.  Every kernel produces identical output on every platform. */
+	FixedPoint
+};
+
+/**
+* Pixel layouts the luminance conversion can write.  Packed formats store the leftmost pixel of each group in the
+* most significant bits of the byte, and every row starts on a byte boundary.
+*/
+enum class EXboxFrontPanelScreenFormat : uint8
+{
+	/** One byte per pixel. */
+	R8,
+
+	/** Two pixels per byte, 16 grey levels. */
+	R4,
+
+	/** Eight pixels per byte, each pixel on if its luminance is at or above XboxFrontPanel.MonochromeThreshold. */
+	R1Threshold,
+
+	/** Eight pixels per byte, ordered with an 8x8 Bayer pattern so gradients survive the reduction to one bit. */
+	R1Dithered
+};
+
+/**
+* Pixel layouts the luminance conversion can read, matching the render target formats the screen can be drawn into.
+* Colour values are taken as display values, the same ones an 8 bit target would have stored.
+*/
+enum class EXboxFrontPanelSourceFormat : uint8
+{
+	/** Four bytes per pixel, blue first.  PF_B8G8R8A8. */
+	BGRA8,
+
+	/** Four bytes per pixel, red first.  PF_R8G8B8A8. */
+	RGBA8,
+
+	/** 10 bits per colour channel packed into a little endian dword, red in the low bits.  PF_A2B10G10R10. */
+	RGB10A2,
+
+	/** Four half floats per pixel, red first, clamped to 0-1.  PF_FloatRGBA. */
+	FloatRGBA16,
+
+	Count
+};
+
+/**
+* Standalone luminance conversion kernels.  These have no dependency on the front panel hardware so they
+* can be exercised and benchmarked on any platform.
+*
+* The widest kernel supported by the host CPU is selected on first use.  The XboxFrontPanel.LuminanceKernel
+* console variable can force a narrower kernel for comparison.
+*/
+class XBOXFRONTPANEL_API FXboxFrontPanelLuminance
+{
+public:
+
+	/**
+	* Convert a BGRA8 surface to one byte of luminance per pixel using the active kernel and mode.
+	*
+	* @param Src		First pixel of the source surface.
+	* @param SrcPitch	Distance in bytes between source rows.
+	* @param Dest		First pixel of the destination surface.
+	* @param DestPitch	Distance in bytes between destination rows.
+	* @param Width		Pixels per row.
+	* @param Height		Number of rows.
+	*/
+	static void ConvertBGRA8ToR8(const uint8* Src, uint32 SrcPitch, uint8* Dest, uint32 DestPitch, uint32 Width, uint32 Height);
+
+	/**
+	* Convert a BGRA8 surface to one byte of luminance per pixel using a specific kernel and mode.  The kernel
+	* must be supported by the host (see IsKernelSupported).
+	*/
+	static void ConvertBGRA8ToR8(EXboxFrontPanelLuminanceKernel Kernel, EXboxFrontPanelLuminanceMode Mode, const uint8* Src, uint32 SrcPitch, uint8* Dest, uint32 DestPitch, uint32 Width, uint32 Height);
+
+	/**
+	* Convert a BGRA8 surface to luminance in the given screen format using the active kernel and mode.
+	*
+	* @param Format		Layout to write to Dest.
+	* @param FirstRow	Screen row that Src starts at.  Only used to align the dither pattern when converting
+	*					part of a surface.
+	*/
+	static void ConvertBGRA8(EXboxFrontPanelScreenFormat Format, const uint8* Src, uint32 SrcPitch, uint8* Dest, uint32 DestPitch, uint32 Width, uint32 Height, uint32 FirstRow = 0);
+
+	/** Convert a BGRA8 surface to luminance in the given screen format using a specific kernel and mode. */
+	static void ConvertBGRA8(EXboxFrontPanelScreenFormat Format, EXboxFrontPanelLuminanceKernel Kernel, EXboxFrontPanelLuminanceMode Mode, const uint8* Src, uint32 SrcPitch, uint8* Dest, uint32 DestPitch, uint32 Width, uint32 Height, uint32 FirstRow = 0);
+
+	/**
+	* Convert a surface in any source format to luminance in the given screen format using the active kernel and mode.
+	* Each row goes through a luminance loop chosen for the source format and kernel, templated on the channel order for
+	* BGRA8 and RGBA8.  R8 screens get that loop's output directly.  R4 and R1 screens convert the row in chunks of a
+	* few hundred pixels, each packed by a shared per-row packer while still in cache: SSE4.1 for every vector kernel,
+	* scalar otherwise.
+	*
+	* Wider sources have fewer loops.  RGB10A2 has scalar, SSE4.1 and AVX2 loops, so AVX-512 uses AVX2.  FloatRGBA16
+	* has scalar and AVX2 loops, the latter also needing F16C, so SSE4.1, and AVX2 or AVX-512 without F16C, use scalar.
+	*
+	* Only 8 bit sources honour the mode.  Wider sources are always converted in fixed point, after rounding each
+	* channel to 8 bits for half floats, so their results are bit-exact across kernels and platforms.
+	*
+	* @param Source		Layout of Src.
+	* @param Format		Layout to write to Dest.
+	* @param FirstRow	Screen row that Src starts at.  Only used to align the dither pattern.
+	*/
+	static void Convert(EXboxFrontPanelSourceFormat Source, EXboxFrontPanelScreenFormat Format, const uint8* Src, uint32 SrcPitch, uint8* Dest, uint32 DestPitch, uint32 Width, uint32 Height, uint32 FirstRow = 0);
+
+	/** Convert a surface in any source format to luminance in the given screen format using a specific kernel and mode. */
+	static void Convert(EXboxFrontPanelSourceFormat Source, EXboxFrontPanelScreenFormat Format, EXboxFrontPanelLuminanceKernel Kernel, EXboxFrontPanelLuminanceMode Mode, const uint8* Src, uint32 SrcPitch, uint8* Dest, uint32 DestPitch, uint32 Width, uint32 Height, uint32 FirstRow = 0);
+
+	/**
+	* Pack a surface that is already one byte of luminance per pixel into the given screen format, for content drawn
+	* on the CPU.  R8 is a plain copy.
+	*
+	* @param FirstRow	Screen row that Src starts at.  Only used to align the dither pattern.
+	*/
+	static void PackR8(EXboxFrontPanelScreenFormat Format, const uint8* Src, uint32 SrcPitch, uint8* Dest, uint32 DestPitch, uint32 Width, uint32 Height, uint32 FirstRow = 0);
+
+	/**
+	* Expand a surface in the given screen format to one byte per pixel, for viewing.  4 bit levels are scaled to the
+	* full 8 bit range and 1 bit pixels become 0 or 255.  R8 is a plain copy.
+	*/
+	static void UnpackR8(EXboxFrontPanelScreenFormat Format, const uint8* Src, uint32 SrcPitch, uint8* Dest, uint32 DestPitch, uint32 Width, uint32 Height);
+
+	/** @return		Bytes needed to hold one row of Width pixels in the given format. */
+	static uint32 GetRowBytes(EXboxFrontPanelScreenFormat Format, uint32 Width);
+
+	/** @return		Human readable format name, for logging. */
+	static const TCHAR* GetFormatName(EXboxFrontPanelScreenFormat Format);
+
+	/** @return		Bytes each pixel of the given source format takes. */
+	static uint32 GetSourceBytesPerPixel(EXboxFrontPanelSourceFormat Source);
+
+	/** @return		Human readable source format name, for logging. */
+	static const TCHAR* GetSourceFormatName(EXboxFrontPanelSourceFormat Source);
+
+	/** @return		True if the host CPU and OS can execute the given kernel. */
+	static bool IsKernelSupported(EXboxFrontPanelLuminanceKernel Kernel);
+
+	/** @return		The widest kernel supported by the host CPU. */
+	static EXboxFrontPanelLuminanceKernel GetBestKernel();
+
+	/** @return		The kernel used by ConvertBGRA8ToR8 when none is specified. */
+	static EXboxFrontPanelLuminanceKernel GetActiveKernel();
+
+	/** @return		The mode used by ConvertBGRA8ToR8 when none is specified, from XboxFrontPanel.LuminanceMode. */
+	static EXboxFrontPanelLuminanceMode GetActiveMode();
+
+	/** @return		Number of pixels processed by each iteration of the kernel's inner loop. */
+	static uint32 GetPixelsPerIteration(EXboxFrontPanelLuminanceKernel Kernel);
+
+	/** @return		Human readable kernel name, for logging. */
+	static const TCHAR* GetKernelName(EXboxFrontPanelLuminanceKernel Kernel);
+};
@@ -9,8 +9,12 @@
 
 class SWidget;
 class UUserWidget;
+class IXboxFrontPanelDevice;
+class UXboxFrontPanelLightSequence;
+class FXboxFrontPanelCanvas;
+struct FXboxFrontPanelInputConfig;
 
-UENUM()
+UENUM(meta = (Bitflags))
 enum class EXboxFrontPanelButtonLight : uint8
 {
 	Button1,
@@ -82,6 +86,34 @@ public:
 	*/
 	virtual bool GetButtonLightState(EXboxFrontPanelButtonLight Light) = 0;
 
+	/**
+	* Set every front panel button light at once.  Like SetButtonLightState, the change reaches the device at the
+	* end of the current tick, in a single call shared with any other light changes made during the tick.
+	*
+	* @param Mask	Bit N is the light for EXboxFrontPanelButtonLight value N.  Set bits switch lights on.
+	*/
+	virtual void SetButtonLightMask(int32 Mask) = 0;
+
+	/**
+	* @return		Bit N set if the light for EXboxFrontPanelButtonLight value N is on.  Zero if the front panel is
+	*				not currently available.
+	*/
+	virtual int32 GetButtonLightMask() = 0;
+
+	/**
+	* Start playing a light sequence, or restart it if it is already playing.  Sequences are evaluated once per tick
+	* and override SetButtonLightState for the lights they cover, without changing what GetButtonLightState reports.
+	*
+	* @param Sequence	Sequence to play.  The module keeps it referenced until it stops.
+	*/
+	virtual void PlayLightSequence(UXboxFrontPanelLightSequence* Sequence) = 0;
+
+	/** Stop a playing light sequence.  Its lights fall back to lower priority sequences or SetButtonLightState. */
+	virtual void StopLightSequence(UXboxFrontPanelLightSequence* Sequence) = 0;
+
+	/** Stop every playing light sequence. */
+	virtual void StopAllLightSequences() = 0;
+
 	/**
 	* Provide a Slate Widget for display on the front panel screen.  The front panel module will take ownership
 	* of the widget, updating and rendering it until the current widget is changed.  The widget will be asked to
@@ -103,4 +135,102 @@ public:
 	* @param Light	Slate widget to display on the front screen.  Null to clear the front panel screen.
 	*/
 	virtual void SetScreenWidget(UUserWidget* Widget) = 0;
+
+	/**
+	* Request that the front panel screen widget be painted on the next tick.  Only needed when
+	* XboxFrontPanel.RedrawMode is 1 and the widget changes in a way the module cannot detect, for example
+	* text or images updated from game code.
+	*/
+	virtual void MarkScreenDirty() = 0;
+
+	/**
+	* Create the window, render target and readback surfaces the screen widget is drawn with, ahead of the first
+	* SetScreenWidget call, so that showing panel UI later allocates nothing and does not wait on the render thread.
+	* Creation itself never waits on the render thread either; the render side work is queued behind the call.  Call
+	* at startup or during loading.  Resources are kept until XboxFrontPanel.ScreenKeepAliveTime after a screen widget
+	* is cleared.  Setting XboxFrontPanel.PrewarmScreen does this once the engine has initialized.
+	*
+	* @return		True if the screen can be used, whether or not it was already prewarmed.
+	*/
+	virtual bool PrewarmScreen() = 0;
+
+	/**
+	* Register a Slate widget as a named page for ShowScreen.  Each page keeps its own window, so its layout survives
+	* other pages being shown, and the last frame it presented, which goes straight back up when the page is shown
+	* again while its live render catches up.  Registering a name again replaces the page.
+	*
+	* @return		False if there is no usable screen.
+	*/
+	virtual bool RegisterScreen(FName Name, TSharedPtr<SWidget> Widget) = 0;
+
+	/** Register a UMG widget as a named page for ShowScreen.  See above. */
+	virtual bool RegisterScreen(FName Name, UUserWidget* Widget) = 0;
+
+	/** Forget a page and its cached frame, clearing the screen if the page is showing. */
+	virtual void UnregisterScreen(FName Name) = 0;
+
+	/**
+	* Show a registered page in place of the current screen widget, with no new prepass for a page shown before.
+	* SetScreenWidget replaces the page, and SetScreenWidget(nullptr) clears it.
+	*
+	* @return		False if no page is registered under Name.
+	*/
+	virtual bool ShowScreen(FName Name) = 0;
+
+	/** @return		The page ShowScreen is showing, or NAME_None. */
+	virtual FName GetActiveScreen() = 0;
+
+	/**
+	* @return		Size of the front panel screen in pixels, or zero if there is no usable screen.
+	*/
+	virtual FIntPoint GetScreenSize() = 0;
+
+	/**
+	* Show a CPU drawn canvas on the front panel screen.  The canvas is packed into the panel's pixel format and
+	* presented from the calling thread, so it never involves Slate, the render thread or the GPU.  Presenting a canvas
+	* identical to the previous one does nothing.  See XboxFrontPanelCanvas.h.
+	*
+	* Ignored while a screen widget is set; call SetScreenWidget(nullptr) first to switch over.
+	*
+	* @param Canvas	Canvas to show.  Must be the size returned by GetScreenSize.
+	*
+	* @return		True if the canvas was accepted.
+	*/
+	virtual bool PresentCanvas(const FXboxFrontPanelCanvas& Canvas) = 0;
+
+	/**
+	* Play a cooked animation (see XboxFrontPanelAnimation.h) on the front panel screen at its authored frame rate.
+	* Frames are streamed from the file and presented like a canvas, without Slate or the GPU.  Replaces any playing
+	* animation; PresentCanvas and SetScreenWidget stop it.  A finished non-looping animation leaves its last frame up.
+	*
+	* Ignored while a screen widget is set.
+	*
+	* @param Filename	Cooked animation the size of the screen.
+	* @param bLoop		Restart from the first frame after the last instead of stopping.
+	*
+	* @return		True if the animation started.
+	*/
+	virtual bool PlayAnimation(const FString& Filename, bool bLoop) = 0;
+
+	/** Stop the playing animation, leaving the current frame on the screen. */
+	virtual void StopAnimation() = 0;
+
+	/** @return		True while an animation is playing. */
+	virtual bool IsAnimationPlaying() = 0;
+
+	/**
+	* Access the backend the module drives, for tools and automated tests.  See XboxFrontPanelDevice.h.
+	*
+	* @return		The real or simulated panel, or null if neither is present.
+	*/
+	virtual IXboxFrontPanelDevice* GetDevice() = 0;
+
+	/**
+	* Replace the rules used to turn front panel buttons into key events: per-button repeat timing, chords and
+	* long presses, and which keys are offered to the screen widget.  See XboxFrontPanelInput.h.
+	*/
+	virtual void SetInputConfig(const FXboxFrontPanelInputConfig& Config) = 0;
+
+	/** @return		The rules currently used to turn front panel buttons into key events. */
+	virtual const FXboxFrontPanelInputConfig& GetInputConfig() = 0;
 };
\ No newline at end of file
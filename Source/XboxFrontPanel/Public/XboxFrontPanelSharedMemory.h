@@ -0,0 +1,80 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+* Layout of the named shared memory region a title started with -XboxFrontPanelShare publishes the front panel
+* through, for a viewer process on the same machine (see UXboxFrontPanelViewerCommandlet):
+*
+*	FXboxFrontPanelSharedMemoryHeader, padded to HeaderSize
+*	SlotCount slots, SlotStride bytes apart, each:
+*		FXboxFrontPanelSharedMemorySlot, padded to SlotHeaderSize
+*		RowBytes x Height bytes of the buffer given to PresentBuffer, in the screen's format
+*
+* The title is the only writer of frames and lights and never waits for the viewer.  Frame N goes to slot
+* N % SlotCount: the slot's Sequence is set to 2N + 1, the frame is written, Sequence is set to 2N + 2 and FrameCount
+* to N + 1.  A reader copies the slot FrameCount points at and keeps the copy only if Sequence read 2 * FrameCount
+* both before and after, so a frame overwritten while it was being read is dropped rather than torn.
+*
+* The viewer is the only writer of InjectedButtons, which the title adds to the buttons the panel reports.  It bumps
+* ViewerHeartbeat at least every ViewerTimeout seconds while injecting; the title ignores injected buttons once the
+* heartbeat stops, so a viewer that exits or crashes cannot leave buttons held.
+*/
+namespace XboxFrontPanelSharedMemory
+{
+	static const uint32 Magic = 0x48535046; // "FPSH"
+	static const uint32 Version = 1;
+
+	/** Region name used when -XboxFrontPanelShare is not given one. */
+	static const TCHAR* const DefaultName = TEXT("XboxFrontPanel");
+
+	static const uint32 SlotCount = 4;
+
+	static const uint32 HeaderSize = 64;
+	static const uint32 SlotHeaderSize = 16;
+
+	/** Slots start on this boundary. */
+	static const uint32 SlotAlignment = 64;
+
+	static const double ViewerTimeout = 1.0;
+}
+
+struct FXboxFrontPanelSharedMemoryHeader
+{
+	/** Written last when the region is laid out, so a viewer never sees a partial header. */
+	volatile int32 Magic;
+	uint32 Version;
+
+	uint32 Width;
+	uint32 Height;
+
+	/** EXboxFrontPanelScreenFormat of the frames. */
+	uint32 Format;
+	uint32 RowBytes;
+
+	uint32 SlotCount;
+	uint32 SlotStride;
+
+	/** Frames published so far. */
+	volatile int64 FrameCount;
+
+	/** EXboxFrontPanelLights last given to the panel. */
+	volatile int32 Lights;
+
+	/** EXboxFrontPanelButtons held by the viewer. */
+	volatile int32 InjectedButtons;
+	volatile int32 ViewerHeartbeat;
+};
+
+static_assert(sizeof(FXboxFrontPanelSharedMemoryHeader) <= XboxFrontPanelSharedMemory::HeaderSize, "FXboxFrontPanelSharedMemoryHeader must fit in HeaderSize");
+
+struct FXboxFrontPanelSharedMemorySlot
+{
+	/** 2N + 1 while frame N is being written, 2N + 2 once it is complete. */
+	volatile int64 Sequence;
+};
+
+static_assert(sizeof(FXboxFrontPanelSharedMemorySlot) <= XboxFrontPanelSharedMemory::SlotHeaderSize, "FXboxFrontPanelSharedMemorySlot must fit in SlotHeaderSize");
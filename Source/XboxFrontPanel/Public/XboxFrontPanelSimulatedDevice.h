@@ -0,0 +1,92 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "XboxFrontPanelDevice.h"
+#include "HAL/CriticalSection.h"
+
+/**
+* In-process stand-in for the front panel hardware.  Presents land in an in-memory framebuffer, button input
+* comes from a script, and every device call can be given an artificial latency through the
+* XboxFrontPanel.Sim.* console variables.  Lets the full pipeline run on platforms with no panel.
+*
+* Selected at startup with XboxFrontPanel.Simulate=1 or -XboxFrontPanelSim when no real panel is present.
+*/
+class XBOXFRONTPANEL_API FXboxFrontPanelSimulatedDevice :
+	public IXboxFrontPanelDevice
+{
+public:
+	FXboxFrontPanelSimulatedDevice(uint32 InWidth, uint32 InHeight, EXboxFrontPanelScreenFormat InFormat);
+
+	/** Create a device configured from XboxFrontPanel.Sim.Width, Height and BitsPerPixel. */
+	static TSharedPtr<FXboxFrontPanelSimulatedDevice, ESPMode::ThreadSafe> CreateFromConsoleVariables();
+
+public:
+	virtual bool GetScreenInfo(uint32& OutWidth, uint32& OutHeight, EXboxFrontPanelScreenFormat& OutFormat) override;
+	virtual bool PresentBuffer(const uint8* Data, uint32 Size) override;
+	virtual bool GetButtonStates(EXboxFrontPanelButtons& OutButtons) override;
+	virtual bool GetLightStates(EXboxFrontPanelLights& OutLights) override;
+	virtual bool SetLightStates(EXboxFrontPanelLights Lights) override;
+	virtual const TCHAR* GetName() const override { return TEXT("Simulated"); }
+	virtual bool IsSimulated() const override { return true; }
+
+public:
+	/** Buttons reported whenever no script step is playing.  Does not affect a script that is playing. */
+	void SetButtonStates(EXboxFrontPanelButtons Buttons);
+
+	/**
+	* Append a step to the button script.  Steps play back to back, each holding its buttons for Duration
+	* seconds, starting as soon as the first step is queued.  Once the script runs out the buttons set with
+	* SetButtonStates are reported again.
+	*/
+	void QueueButtonStep(EXboxFrontPanelButtons Buttons, double Duration);
+
+	/** Drop any script steps that have not finished playing. */
+	void ClearButtonScript();
+
+	/** @return		True while script steps remain. */
+	bool IsButtonScriptPlaying() const;
+
+	/**
+	* Copy out the most recent present.
+	*
+	* @return		Number of presents so far.  Zero if nothing has been presented, in which case OutData is empty.
+	*/
+	uint32 CopyFramebuffer(TArray<uint8>& OutData) const;
+
+	/** Write the most recent present to a binary PGM image, expanded to 8 bits per pixel. */
+	bool SaveFramebuffer(const FString& Filename) const;
+
+	/** @return		Number of SetLightStates calls so far. */
+	uint32 GetLightCommitCount() const;
+
+	/**
+	* Parse None, or button names joined with +, from Button1-5, Left, Right, Up, Down and Select.  The syntax used
+	* by XboxFrontPanel.Sim.Buttons and the viewer's button scripts.
+	*/
+	static bool ParseButtons(const FString& Text, EXboxFrontPanelButtons& OutButtons);
+
+private:
+	struct FButtonStep
+	{
+		EXboxFrontPanelButtons Buttons;
+		double EndTime;
+	};
+
+	const uint32 Width;
+	const uint32 Height;
+	const EXboxFrontPanelScreenFormat Format;
+
+	mutable FCriticalSection Lock;
+
+	TArray<uint8> Framebuffer;
+	uint32 PresentCount;
+
+	EXboxFrontPanelButtons ButtonStates;
+	TArray<FButtonStep> ButtonScript;
+
+	EXboxFrontPanelLights LightStates;
+	uint32 LightCommitCount;
+};
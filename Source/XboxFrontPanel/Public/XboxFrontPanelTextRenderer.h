@@ -0,0 +1,85 @@
+//*********************************************************
+// Copyright (c) Microsoft. All rights reserved.
+//*********************************************************
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+
+class FXboxFrontPanelCanvas;
+class UXboxFrontPanelFont;
+
+/**
+* Horizontal placement of each line of text relative to the position given to DrawText.
+*/
+enum class EXboxFrontPanelTextAlign : uint8
+{
+	/** Lines start at the position. */
+	Left,
+
+	/** Lines are centered on the position. */
+	Center,
+
+	/** Lines end at the position. */
+	Right
+};
+
+/**
+* Draws text from a baked UXboxFrontPanelFont onto an FXboxFrontPanelCanvas.  Glyphs are blended straight from the
+* atlas with no shaping or kerning.  Layouts of recently drawn strings are cached, so redrawing a label or a
+* changing score mostly costs the glyph blends.  Line feeds start new lines.
+*
+* Game thread only.  Keeps the font referenced for as long as the renderer exists.
+*/
+class XBOXFRONTPANEL_API FXboxFrontPanelTextRenderer : public FGCObject
+{
+public:
+	/**
+	* @param InFont				Baked font to draw with.
+	* @param InMaxCachedLayouts	Number of distinct strings whose layout is kept.  The least recently drawn is dropped
+	*							when another is needed.
+	*/
+	explicit FXboxFrontPanelTextRenderer(UXboxFrontPanelFont* InFont, int32 InMaxCachedLayouts = 32);
+
+	UXboxFrontPanelFont* GetFont() const { return Font; }
+
+	/** @return		Width of the longest line and height of all lines of Text, in pixels. */
+	FIntPoint MeasureText(const FString& Text);
+
+	/**
+	* Draw Text onto Canvas, clipped to the canvas clip rect.
+	*
+	* @param Position	Top of the first line.  Horizontally, where lines start, center or end depending on Align.
+	* @param Value		Luminance of the text.
+	*/
+	void DrawText(FXboxFrontPanelCanvas& Canvas, const FString& Text, FIntPoint Position, uint8 Value = 255, EXboxFrontPanelTextAlign Align = EXboxFrontPanelTextAlign::Left);
+
+	/** Forget every cached layout.  Needed if the font is rebaked while the renderer is in use. */
+	void ClearCache();
+
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+
+private:
+	struct FPlacedGlyph
+	{
+		int32 GlyphIndex;
+		int16 X;
+		int16 Y;
+		int16 Line;
+	};
+
+	struct FTextLayout
+	{
+		TArray<FPlacedGlyph> Glyphs;
+		TArray<int32> LineWidths;
+		FIntPoint Size;
+		uint64 LastUsed;
+	};
+
+	const FTextLayout& GetLayout(const FString& Text);
+
+	UXboxFrontPanelFont* Font;
+	TMap<FString, FTextLayout> LayoutCache;
+	int32 MaxCachedLayouts;
+	uint64 UseCounter;
+};
@@ -17,10 +17,17 @@ public class XboxFrontPanel : ModuleRules
 				"Engine",
 				"RHI",
 				"Slate",
+				"SlateCore",
 				"UMG",
 				"InputCore"
 			});
 
+		if (Target.bBuildEditor)
+		{
+			// Only the animation cook commandlet decodes images
+			PrivateDependencyModuleNames.Add("ImageWrapper");
+		}
+
 		if (Target.Platform == UnrealTargetPlatform.XboxOne)
 		{
 			PublicAdditionalLibraries.Add("XboxFrontPanel.lib");